@@ -0,0 +1,81 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * fixture.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include "fixture.hpp"
+
+#include <stdexcept>
+
+namespace bench {
+
+    namespace {
+        const char* const Schema = "CREATE TABLE foo ("
+                                   "id INTEGER PRIMARY KEY, "
+                                   "number INTEGER, "
+                                   "real REAL, "
+                                   "text TEXT, "
+                                   "data BLOB"
+                                   ")";
+
+        std::string fillSql ()
+        {
+            return "WITH RECURSIVE n (i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n "
+                   "WHERE i < "
+                + std::to_string (Rows)
+                + ") INSERT INTO foo (number, real, text, data) "
+                  "SELECT i, i / 3.0, 'Mr. Number ' || i, randomblob (64) FROM n";
+        }
+    } // namespace
+
+    RawDatabase::RawDatabase () : db_ {nullptr}
+    {
+        if (sqlite3_open (":memory:", &db_) != SQLITE_OK) {
+            throw std::runtime_error {"Unable to open the database"};
+        }
+    }
+
+    RawDatabase::~RawDatabase () { sqlite3_close (db_); }
+
+    void RawDatabase::execute (const std::string& sql)
+    {
+        if (sqlite3_exec (db_, sql.c_str (), nullptr, nullptr, nullptr) != SQLITE_OK) {
+            throw std::runtime_error {sqlite3_errmsg (db_)};
+        }
+    }
+
+    void createTable (cqlite::Database& db) { db << Schema; }
+
+    void createTable (RawDatabase& db) { db.execute (Schema); }
+
+    void fill (cqlite::Database& db)
+    {
+        createTable (db);
+        db << fillSql ();
+    }
+
+    void fill (RawDatabase& db)
+    {
+        createTable (db);
+        db.execute (fillSql ());
+    }
+} // namespace bench
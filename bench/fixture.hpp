@@ -0,0 +1,70 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * fixture.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_BENCH_FIXTURE_INC
+#define CQLITE_BENCH_FIXTURE_INC
+
+#include <cqlite/database.hpp>
+
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <string>
+
+namespace bench {
+
+    /** The number of rows in the table of a filled database. */
+    constexpr std::size_t Rows = 1000;
+
+    /**
+     * A raw connection, the counterpart of cqlite::Database in the benchmarks of the
+     * plain C API.
+     */
+    class RawDatabase
+    {
+      public:
+        RawDatabase ();
+        ~RawDatabase ();
+
+        RawDatabase (const RawDatabase&) = delete;
+        RawDatabase& operator= (const RawDatabase&) = delete;
+
+        sqlite3* get () const;
+
+        void execute (const std::string&);
+
+      private:
+        sqlite3* db_;
+    };
+
+    void createTable (cqlite::Database&);
+    void createTable (RawDatabase&);
+
+    void fill (cqlite::Database&);
+    void fill (RawDatabase&);
+
+    inline sqlite3* RawDatabase::get () const { return db_; }
+} // namespace bench
+
+#endif /* CQLITE_BENCH_FIXTURE_INC */
@@ -0,0 +1,372 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * reads.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include "fixture.hpp"
+
+#include <cqlite/database.hpp>
+#include <cqlite/statement.hpp>
+
+#include <benchmark/benchmark.h>
+#include <sqlite3.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace cqlite;
+using bench::RawDatabase;
+
+namespace {
+    const char* const Lookup = "SELECT number FROM foo WHERE id = ?1";
+    const char* const Scan = "SELECT id, number, real, text FROM foo";
+    const char* const Echo = "SELECT ?1";
+
+    const std::string Text (32, 't');
+    const std::vector<unsigned char> Blob (4096, 0xb);
+} // namespace
+
+static void prepare_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::fill (db);
+
+    for (auto _ : state) {
+        Statement statement = db.prepare (Lookup);
+        benchmark::DoNotOptimize (statement);
+    }
+}
+BENCHMARK (prepare_cqlite);
+
+static void prepare_cached_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::fill (db);
+    db.cacheStatements (16);
+
+    for (auto _ : state) {
+        Statement statement = db.prepare (Lookup);
+        benchmark::DoNotOptimize (statement);
+    }
+}
+BENCHMARK (prepare_cached_cqlite);
+
+static void prepare_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::fill (db);
+
+    for (auto _ : state) {
+        sqlite3_stmt* stmt = nullptr;
+        sqlite3_prepare_v2 (db.get (), Lookup, -1, &stmt, nullptr);
+        benchmark::DoNotOptimize (stmt);
+        sqlite3_finalize (stmt);
+    }
+}
+BENCHMARK (prepare_raw);
+
+template <typename Value>
+static void bind_cqlite (benchmark::State& state, Value value)
+{
+    Database db {":memory:"};
+    Statement statement = db.prepare (Echo);
+
+    for (auto _ : state) {
+        statement.reset ();
+        statement << value;
+    }
+}
+BENCHMARK_CAPTURE (bind_cqlite, int, 42);
+BENCHMARK_CAPTURE (bind_cqlite, int64, std::int64_t {42});
+BENCHMARK_CAPTURE (bind_cqlite, double, 4.2);
+BENCHMARK_CAPTURE (bind_cqlite, string, Text);
+BENCHMARK_CAPTURE (bind_cqlite, string_view, std::string_view {Text});
+BENCHMARK_CAPTURE (bind_cqlite, borrowed_text, borrow (Text));
+BENCHMARK_CAPTURE (bind_cqlite, blob, BlobView {Blob});
+BENCHMARK_CAPTURE (bind_cqlite, borrowed_blob, borrow (BlobView {Blob}));
+
+static void bind_raw_int (benchmark::State& state)
+{
+    RawDatabase db;
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Echo, -1, &stmt, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_reset (stmt);
+        sqlite3_bind_int (stmt, 1, 42);
+    }
+
+    sqlite3_finalize (stmt);
+}
+BENCHMARK (bind_raw_int);
+
+static void bind_raw_double (benchmark::State& state)
+{
+    RawDatabase db;
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Echo, -1, &stmt, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_reset (stmt);
+        sqlite3_bind_double (stmt, 1, 4.2);
+    }
+
+    sqlite3_finalize (stmt);
+}
+BENCHMARK (bind_raw_double);
+
+static void bind_raw_text (benchmark::State& state, sqlite3_destructor_type destructor)
+{
+    RawDatabase db;
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Echo, -1, &stmt, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_reset (stmt);
+        sqlite3_bind_text (
+            stmt, 1, Text.data (), static_cast<int> (Text.size ()), destructor);
+    }
+
+    sqlite3_finalize (stmt);
+}
+BENCHMARK_CAPTURE (bind_raw_text, transient, SQLITE_TRANSIENT);
+BENCHMARK_CAPTURE (bind_raw_text, static, SQLITE_STATIC);
+
+static void bind_raw_blob (benchmark::State& state, sqlite3_destructor_type destructor)
+{
+    RawDatabase db;
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Echo, -1, &stmt, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_reset (stmt);
+        sqlite3_bind_blob (
+            stmt, 1, Blob.data (), static_cast<int> (Blob.size ()), destructor);
+    }
+
+    sqlite3_finalize (stmt);
+}
+BENCHMARK_CAPTURE (bind_raw_blob, transient, SQLITE_TRANSIENT);
+BENCHMARK_CAPTURE (bind_raw_blob, static, SQLITE_STATIC);
+
+static void scan_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::fill (db);
+    Statement statement = db.prepare (Scan);
+
+    for (auto _ : state) {
+        statement.reset ();
+
+        for (Result result = statement.execute (); result; ++result) {
+            std::int64_t id;
+            int number;
+            double real;
+            std::string text;
+
+            result >> id >> number >> real >> text;
+            benchmark::DoNotOptimize (text);
+        }
+    }
+
+    state.SetItemsProcessed (state.iterations () * bench::Rows);
+}
+BENCHMARK (scan_cqlite);
+
+static void scan_views_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::fill (db);
+    Statement statement = db.prepare (Scan);
+
+    for (auto _ : state) {
+        statement.reset ();
+
+        for (Result result = statement.execute (); result; ++result) {
+            std::int64_t id;
+            int number;
+            double real;
+            std::string_view text;
+
+            result >> id >> number >> real >> text;
+            benchmark::DoNotOptimize (text);
+        }
+    }
+
+    state.SetItemsProcessed (state.iterations () * bench::Rows);
+}
+BENCHMARK (scan_views_cqlite);
+
+static void scan_rows_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::fill (db);
+    Statement statement = db.prepare (Scan);
+
+    for (auto _ : state) {
+        statement.reset ();
+
+        for (const auto& row :
+            statement.rows<std::int64_t, int, double, std::string_view> ()) {
+            benchmark::DoNotOptimize (row);
+        }
+    }
+
+    state.SetItemsProcessed (state.iterations () * bench::Rows);
+}
+BENCHMARK (scan_rows_cqlite);
+
+static void scan_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::fill (db);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Scan, -1, &stmt, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_reset (stmt);
+
+        while (sqlite3_step (stmt) == SQLITE_ROW) {
+            std::int64_t id = sqlite3_column_int64 (stmt, 0);
+            int number = sqlite3_column_int (stmt, 1);
+            double real = sqlite3_column_double (stmt, 2);
+            const unsigned char* text = sqlite3_column_text (stmt, 3);
+            int size = sqlite3_column_bytes (stmt, 3);
+
+            benchmark::DoNotOptimize (id);
+            benchmark::DoNotOptimize (number);
+            benchmark::DoNotOptimize (real);
+            benchmark::DoNotOptimize (text);
+            benchmark::DoNotOptimize (size);
+        }
+    }
+
+    sqlite3_finalize (stmt);
+    state.SetItemsProcessed (state.iterations () * bench::Rows);
+}
+BENCHMARK (scan_raw);
+
+static void lookup_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::fill (db);
+    Statement statement = db.prepare (Lookup);
+    int id = 0;
+
+    for (auto _ : state) {
+        int number;
+
+        statement.reset ();
+        statement << (id++ % static_cast<int> (bench::Rows)) + 1;
+        statement.execute () >> number;
+
+        benchmark::DoNotOptimize (number);
+    }
+}
+BENCHMARK (lookup_cqlite);
+
+static void lookup_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::fill (db);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Lookup, -1, &stmt, nullptr);
+    int id = 0;
+
+    for (auto _ : state) {
+        sqlite3_reset (stmt);
+        sqlite3_bind_int (stmt, 1, (id++ % static_cast<int> (bench::Rows)) + 1);
+        sqlite3_step (stmt);
+
+        int number = sqlite3_column_int (stmt, 0);
+        benchmark::DoNotOptimize (number);
+    }
+
+    sqlite3_finalize (stmt);
+}
+BENCHMARK (lookup_raw);
+
+static void blob_round_trip_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::createTable (db);
+    Statement insert = db.prepare ("INSERT INTO foo (id, data) VALUES (1, ?1)");
+    Statement select = db.prepare ("SELECT data FROM foo WHERE id = 1");
+    Statement remove = db.prepare ("DELETE FROM foo");
+
+    for (auto _ : state) {
+        insert.reset ();
+        insert << BlobView {Blob};
+        insert.execute ();
+
+        BlobView data;
+        select.reset ();
+        select.execute () >> data;
+        benchmark::DoNotOptimize (data);
+
+        remove.reset ();
+        remove.execute ();
+    }
+
+    state.SetBytesProcessed (state.iterations () * Blob.size () * 2);
+}
+BENCHMARK (blob_round_trip_cqlite);
+
+static void blob_round_trip_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::createTable (db);
+    sqlite3_stmt* insert = nullptr;
+    sqlite3_stmt* select = nullptr;
+    sqlite3_stmt* remove = nullptr;
+    sqlite3_prepare_v2 (
+        db.get (), "INSERT INTO foo (id, data) VALUES (1, ?1)", -1, &insert, nullptr);
+    sqlite3_prepare_v2 (
+        db.get (), "SELECT data FROM foo WHERE id = 1", -1, &select, nullptr);
+    sqlite3_prepare_v2 (db.get (), "DELETE FROM foo", -1, &remove, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_reset (insert);
+        sqlite3_bind_blob (insert, 1, Blob.data (), static_cast<int> (Blob.size ()),
+            SQLITE_TRANSIENT);
+        sqlite3_step (insert);
+
+        sqlite3_reset (select);
+        sqlite3_step (select);
+        const void* data = sqlite3_column_blob (select, 0);
+        int size = sqlite3_column_bytes (select, 0);
+        benchmark::DoNotOptimize (data);
+        benchmark::DoNotOptimize (size);
+
+        sqlite3_reset (remove);
+        sqlite3_step (remove);
+    }
+
+    sqlite3_finalize (insert);
+    sqlite3_finalize (select);
+    sqlite3_finalize (remove);
+
+    state.SetBytesProcessed (state.iterations () * Blob.size () * 2);
+}
+BENCHMARK (blob_round_trip_raw);
@@ -0,0 +1,232 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * writes.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include "fixture.hpp"
+
+#include <cqlite/database.hpp>
+#include <cqlite/statement.hpp>
+#include <cqlite/transaction.hpp>
+#include <cqlite/typed.hpp>
+
+#include <benchmark/benchmark.h>
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace cqlite;
+using bench::RawDatabase;
+
+namespace {
+    const char* const Insert = "INSERT INTO foo (number, real, text) VALUES (?1, ?2, ?3)";
+
+    using Row = std::tuple<int, double, std::string>;
+
+    std::vector<Row> makeRows ()
+    {
+        std::vector<Row> rows;
+        rows.reserve (bench::Rows);
+
+        for (std::size_t i = 0; i < bench::Rows; ++i) {
+            rows.emplace_back (
+                static_cast<int> (i), i / 3.0, "Mr. Number " + std::to_string (i));
+        }
+
+        return rows;
+    }
+
+    const std::vector<Row> Values = makeRows ();
+
+    void insert (Statement& statement, const Row& row)
+    {
+        statement.reset ();
+        statement << std::get<0> (row) << std::get<1> (row) << std::get<2> (row);
+        statement.execute ();
+    }
+
+    void insert (sqlite3_stmt* stmt, const Row& row)
+    {
+        const std::string& text = std::get<2> (row);
+
+        sqlite3_reset (stmt);
+        sqlite3_bind_int (stmt, 1, std::get<0> (row));
+        sqlite3_bind_double (stmt, 2, std::get<1> (row));
+        sqlite3_bind_text (
+            stmt, 3, text.data (), static_cast<int> (text.size ()), SQLITE_TRANSIENT);
+        sqlite3_step (stmt);
+    }
+
+    void updated (void* count, int, const char*, const char*, sqlite3_int64)
+    {
+        ++*static_cast<std::size_t*> (count);
+    }
+} // namespace
+
+static void insert_autocommit_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::createTable (db);
+    Statement statement = db.prepare (Insert);
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        insert (statement, Values[i++ % Values.size ()]);
+    }
+}
+BENCHMARK (insert_autocommit_cqlite);
+
+static void insert_autocommit_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::createTable (db);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Insert, -1, &stmt, nullptr);
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        insert (stmt, Values[i++ % Values.size ()]);
+    }
+
+    sqlite3_finalize (stmt);
+}
+BENCHMARK (insert_autocommit_raw);
+
+static void insert_hooked_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::createTable (db);
+    std::size_t count = 0;
+    db.addUpdateHook ("foo",
+        [&count] (UpdateOperation, std::string_view, std::string_view, std::int64_t) {
+            ++count;
+        });
+    Statement statement = db.prepare (Insert);
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        insert (statement, Values[i++ % Values.size ()]);
+    }
+
+    benchmark::DoNotOptimize (count);
+}
+BENCHMARK (insert_hooked_cqlite);
+
+static void insert_hooked_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::createTable (db);
+    std::size_t count = 0;
+    sqlite3_update_hook (db.get (), &updated, &count);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Insert, -1, &stmt, nullptr);
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        insert (stmt, Values[i++ % Values.size ()]);
+    }
+
+    sqlite3_finalize (stmt);
+    benchmark::DoNotOptimize (count);
+}
+BENCHMARK (insert_hooked_raw);
+
+static void insert_transaction_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::createTable (db);
+    Statement statement = db.prepare (Insert);
+
+    for (auto _ : state) {
+        Transaction transaction {db, Transaction::Type::Immediate};
+
+        for (const Row& row : Values) {
+            insert (statement, row);
+        }
+
+        transaction.commit ();
+    }
+
+    state.SetItemsProcessed (state.iterations () * Values.size ());
+}
+BENCHMARK (insert_transaction_cqlite);
+
+static void insert_typed_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::createTable (db);
+    TypedStatement<Params<int, double, std::string>, Columns<>> statement {db, Insert};
+
+    for (auto _ : state) {
+        Transaction transaction {db, Transaction::Type::Immediate};
+
+        for (const auto& [number, real, text] : Values) {
+            statement (number, real, text);
+        }
+
+        transaction.commit ();
+    }
+
+    state.SetItemsProcessed (state.iterations () * Values.size ());
+}
+BENCHMARK (insert_typed_cqlite);
+
+static void insert_many_cqlite (benchmark::State& state)
+{
+    Database db {":memory:"};
+    bench::createTable (db);
+    Statement statement = db.prepare (Insert);
+
+    for (auto _ : state) {
+        statement.executeMany (Values);
+    }
+
+    state.SetItemsProcessed (state.iterations () * Values.size ());
+}
+BENCHMARK (insert_many_cqlite);
+
+static void insert_transaction_raw (benchmark::State& state)
+{
+    RawDatabase db;
+    bench::createTable (db);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2 (db.get (), Insert, -1, &stmt, nullptr);
+
+    for (auto _ : state) {
+        sqlite3_exec (db.get (), "BEGIN IMMEDIATE", nullptr, nullptr, nullptr);
+
+        for (const Row& row : Values) {
+            insert (stmt, row);
+        }
+
+        sqlite3_exec (db.get (), "COMMIT", nullptr, nullptr, nullptr);
+    }
+
+    sqlite3_finalize (stmt);
+    state.SetItemsProcessed (state.iterations () * Values.size ());
+}
+BENCHMARK (insert_transaction_raw);
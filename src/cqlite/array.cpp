@@ -0,0 +1,293 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * array.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/array.hpp>
+
+#include <sqlite3.h>
+
+#include <new>
+
+namespace cqlite {
+
+    namespace {
+
+        /** The type of the pointers bound as arrays, so that no other ones are read. */
+        const char* const PointerType = "cqlite-array";
+
+        /** The columns of the table, the hidden one takes the bound array. */
+        enum Column
+        {
+            Value,
+            Pointer
+        };
+
+        struct Cursor : sqlite3_vtab_cursor
+        {
+            const ArrayView* array;
+            std::size_t at;
+        };
+
+        void destroyArray (void* array) { delete static_cast<ArrayView*> (array); }
+
+        int connect (
+            sqlite3* db, void*, int, const char* const*, sqlite3_vtab** vtab, char**)
+        {
+            int result
+                = sqlite3_declare_vtab (db, "CREATE TABLE x (value, pointer HIDDEN)");
+
+            if (result != SQLITE_OK) {
+                return result;
+            }
+
+            *vtab = new (std::nothrow) sqlite3_vtab {};
+
+            return *vtab ? SQLITE_OK : SQLITE_NOMEM;
+        }
+
+        int disconnect (sqlite3_vtab* vtab)
+        {
+            delete vtab;
+            return SQLITE_OK;
+        }
+
+        /**
+         * Reads the array only if it is given as the argument, otherwise the plan is
+         * made too expensive to be chosen.
+         */
+        int bestIndex (sqlite3_vtab*, sqlite3_index_info* info)
+        {
+            for (int i = 0; i < info->nConstraint; ++i) {
+                const auto& constraint = info->aConstraint[i];
+
+                if (constraint.usable && constraint.iColumn == Pointer
+                    && constraint.op == SQLITE_INDEX_CONSTRAINT_EQ) {
+                    info->aConstraintUsage[i].argvIndex = 1;
+                    info->aConstraintUsage[i].omit = 1;
+                    info->idxNum = 1;
+                    info->estimatedCost = 1;
+                    info->estimatedRows = 100;
+
+                    return SQLITE_OK;
+                }
+            }
+
+            info->idxNum = 0;
+            info->estimatedCost = 2147483647;
+            info->estimatedRows = 2147483647;
+
+            return SQLITE_OK;
+        }
+
+        int open (sqlite3_vtab*, sqlite3_vtab_cursor** cursor)
+        {
+            *cursor = new (std::nothrow) Cursor {};
+
+            return *cursor ? SQLITE_OK : SQLITE_NOMEM;
+        }
+
+        int close (sqlite3_vtab_cursor* cursor)
+        {
+            delete static_cast<Cursor*> (cursor);
+            return SQLITE_OK;
+        }
+
+        int filter (
+            sqlite3_vtab_cursor* base, int plan, const char*, int, sqlite3_value** values)
+        {
+            Cursor& cursor = *static_cast<Cursor*> (base);
+
+            // Values that are not bound as arrays give an empty table.
+            cursor.array = plan == 1 ? static_cast<const ArrayView*> (
+                               sqlite3_value_pointer (values[0], PointerType))
+                                     : nullptr;
+            cursor.at = 0;
+
+            return SQLITE_OK;
+        }
+
+        int next (sqlite3_vtab_cursor* cursor)
+        {
+            ++static_cast<Cursor*> (cursor)->at;
+            return SQLITE_OK;
+        }
+
+        int eof (sqlite3_vtab_cursor* base)
+        {
+            const Cursor& cursor = *static_cast<Cursor*> (base);
+
+            return ! cursor.array || cursor.at >= cursor.array->size ();
+        }
+
+        int column (sqlite3_vtab_cursor* base, sqlite3_context* context, int column)
+        {
+            const Cursor& cursor = *static_cast<Cursor*> (base);
+
+            if (column != Value) {
+                sqlite3_result_null (context);
+                return SQLITE_OK;
+            }
+
+            const void* const data = cursor.array->data ();
+
+            switch (cursor.array->type ()) {
+                case ArrayView::Type::Integer:
+                    sqlite3_result_int64 (
+                        context, static_cast<const std::int64_t*> (data)[cursor.at]);
+                    break;
+                case ArrayView::Type::Real:
+                    sqlite3_result_double (
+                        context, static_cast<const double*> (data)[cursor.at]);
+                    break;
+                case ArrayView::Type::Text: {
+                    const std::string& text
+                        = static_cast<const std::string*> (data)[cursor.at];
+                    sqlite3_result_text64 (context, text.data (), text.size (),
+                        SQLITE_STATIC, SQLITE_UTF8);
+                    break;
+                }
+                case ArrayView::Type::TextView: {
+                    std::string_view text
+                        = static_cast<const std::string_view*> (data)[cursor.at];
+                    sqlite3_result_text64 (context, text.data () ? text.data () : "",
+                        text.size (), SQLITE_STATIC, SQLITE_UTF8);
+                    break;
+                }
+            }
+
+            return SQLITE_OK;
+        }
+
+        int rowid (sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+        {
+            *rowid = static_cast<sqlite3_int64> (static_cast<Cursor*> (cursor)->at + 1);
+            return SQLITE_OK;
+        }
+
+        /** An eponymous-only module, the table valued function of the arrays. */
+        const sqlite3_module Module = {
+            0,           // iVersion
+            nullptr,     // xCreate
+            &connect,    // xConnect
+            &bestIndex,  // xBestIndex
+            &disconnect, // xDisconnect
+            &disconnect, // xDestroy
+            &open,       // xOpen
+            &close,      // xClose
+            &filter,     // xFilter
+            &next,       // xNext
+            &eof,        // xEof
+            &column,     // xColumn
+            &rowid,      // xRowid
+            nullptr,     // xUpdate
+            nullptr,     // xBegin
+            nullptr,     // xSync
+            nullptr,     // xCommit
+            nullptr,     // xRollback
+            nullptr,     // xFindFunction
+            nullptr,     // xRename
+            nullptr,     // xSavepoint
+            nullptr,     // xRelease
+            nullptr,     // xRollbackTo
+            nullptr      // xShadowName
+        };
+    } // namespace
+
+    const char* const ArrayView::Function = "cqlite_array";
+
+    /**
+     * An empty array of integers.
+     */
+    ArrayView::ArrayView () noexcept : type_ {Type::Integer}, data_ {nullptr}, size_ {0}
+    {}
+
+    /**
+     * A view of integers.
+     * @param data the first value
+     * @param size the number of values
+     */
+    ArrayView::ArrayView (const std::int64_t* data, std::size_t size) noexcept :
+        type_ {Type::Integer}, data_ {data}, size_ {size}
+    {}
+
+    /**
+     * A view of reals.
+     * @param data the first value
+     * @param size the number of values
+     */
+    ArrayView::ArrayView (const double* data, std::size_t size) noexcept :
+        type_ {Type::Real}, data_ {data}, size_ {size}
+    {}
+
+    /**
+     * A view of texts.
+     * @param data the first value
+     * @param size the number of values
+     */
+    ArrayView::ArrayView (const std::string* data, std::size_t size) noexcept :
+        type_ {Type::Text}, data_ {data}, size_ {size}
+    {}
+
+    /**
+     * A view of text views, which are viewed themselves.
+     * @param data the first value
+     * @param size the number of values
+     */
+    ArrayView::ArrayView (const std::string_view* data, std::size_t size) noexcept :
+        type_ {Type::TextView}, data_ {data}, size_ {size}
+    {}
+
+    namespace detail {
+
+        /**
+         * Binds the given array as a pointer, which only the table valued function of
+         * the arrays reads.
+         * @param stmt the statement
+         * @param index the index of the parameter
+         * @param array the array
+         * @return the result of the binding
+         */
+        int bindArray (sqlite3_stmt* stmt, int index, const ArrayView& array)
+        {
+            ArrayView* const bound = new (std::nothrow) ArrayView {array};
+
+            if (! bound) {
+                return SQLITE_NOMEM;
+            }
+
+            // The copy of the view is destroyed by sqlite, also if the binding fails.
+            return sqlite3_bind_pointer (stmt, index, bound, PointerType, &destroyArray);
+        }
+
+        /**
+         * Registers the table valued function of the arrays with the given connection.
+         * @param db the connection
+         * @return the result of the registration
+         */
+        int installArrays (sqlite3* db)
+        {
+            return sqlite3_create_module_v2 (
+                db, ArrayView::Function, &Module, nullptr, nullptr);
+        }
+    } // namespace detail
+} // namespace cqlite
@@ -0,0 +1,129 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * array.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_ARRAY_INC
+#define CQLITE_ARRAY_INC
+
+#include <cqlite/cqlite_export.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace cqlite {
+
+    /**
+     * A non-owning view of an array of integers, reals or texts, that is bound to a
+     * single parameter and read as a table within sql, e.g.
+     * @code
+
+     std::vector<std::int64_t> ids {3, 5, 8};
+
+     cqlite::Statement select = db.prepare (
+         "SELECT name FROM things WHERE id IN cqlite_array (?1)");
+
+     select << cqlite::array (ids);
+
+     @endcode
+     * The table valued function `cqlite_array` has the column `value`, the rowid of a
+     * value is its position starting at 1. The array is borrowed, it must stay valid
+     * until the parameter is bound again or the statement is destroyed.
+     * @see array
+     */
+    class CQLITE_EXPORT ArrayView
+    {
+      public:
+        enum class Type
+        {
+            Integer,
+            Real,
+            Text,
+            TextView
+        };
+
+        /** The name of the table valued function the arrays are read with. */
+        static const char* const Function;
+
+      public:
+        ArrayView () noexcept;
+        ArrayView (const std::int64_t*, std::size_t) noexcept;
+        ArrayView (const double*, std::size_t) noexcept;
+        ArrayView (const std::string*, std::size_t) noexcept;
+        ArrayView (const std::string_view*, std::size_t) noexcept;
+
+        Type type () const noexcept;
+        const void* data () const noexcept;
+        std::size_t size () const noexcept;
+
+      private:
+        Type type_;
+        const void* data_;
+        std::size_t size_;
+    };
+
+    /**
+     * Views the given contiguous container of std::int64_t, double, std::string or
+     * std::string_view values as an array, in order to bind it to a single parameter.
+     * @param values the values, which must outlive the binding
+     * @return the view of the values
+     * @see ArrayView
+     */
+    template <typename Container>
+    inline auto array (const Container& values)
+        -> decltype (ArrayView {std::data (values), std::size (values)})
+    {
+        return ArrayView {std::data (values), std::size (values)};
+    }
+
+    namespace detail {
+
+        CQLITE_EXPORT int bindArray (sqlite3_stmt*, int, const ArrayView&);
+        CQLITE_EXPORT int installArrays (sqlite3*);
+    } // namespace detail
+
+    /**
+     * The type of the viewed values.
+     * @return the type
+     */
+    inline ArrayView::Type ArrayView::type () const noexcept { return type_; }
+
+    /**
+     * The first of the viewed values.
+     * @return the values
+     */
+    inline const void* ArrayView::data () const noexcept { return data_; }
+
+    /**
+     * The number of the viewed values.
+     * @return the size of the array
+     */
+    inline std::size_t ArrayView::size () const noexcept { return size_; }
+} // namespace cqlite
+
+#endif /* CQLITE_ARRAY_INC */
@@ -0,0 +1,99 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * async.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/async.hpp>
+
+namespace cqlite {
+
+    /**
+     * Opens the database on the calling thread and starts the worker thread.
+     * @param path the path to the database file
+     * @param mode the mode to open the database with, see Database::Mode
+     * @throws DbError if the database cannot be opened
+     */
+    AsyncDatabase::AsyncDatabase (const std::string& path, std::uint8_t mode) :
+        db_ {path, mode},
+        mutex_ {},
+        posted_ {},
+        tasks_ {},
+        stopping_ {false},
+        worker_ {}
+    {
+        worker_ = std::thread {[this] { run (); }};
+    }
+
+    /**
+     * Executes the requests that are still queued and stops the worker thread.
+     */
+    AsyncDatabase::~AsyncDatabase ()
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            stopping_ = true;
+        }
+
+        posted_.notify_one ();
+        worker_.join ();
+    }
+
+    /**
+     * Queues the given sql to be executed.
+     * @param sql the sql, which may consist of several statements
+     * @return the future that becomes ready when the sql has been executed
+     */
+    std::future<void> AsyncDatabase::execute (std::string sql)
+    {
+        return submit ([sql = std::move (sql)] (Database& db) { db << sql; });
+    }
+
+    void AsyncDatabase::post (Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            tasks_.push_back (std::move (task));
+        }
+
+        posted_.notify_one ();
+    }
+
+    void AsyncDatabase::run ()
+    {
+        std::unique_lock<std::mutex> lock {mutex_};
+
+        for (;;) {
+            posted_.wait (lock, [this] { return stopping_ || ! tasks_.empty (); });
+
+            if (tasks_.empty ()) {
+                return;
+            }
+
+            Task task = std::move (tasks_.front ());
+            tasks_.pop_front ();
+
+            lock.unlock ();
+            task (db_);
+            lock.lock ();
+        }
+    }
+} // namespace cqlite
@@ -0,0 +1,321 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * async.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_ASYNC_INC
+#define CQLITE_ASYNC_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/rows.hpp>
+#include <cqlite/statement.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cqlite {
+
+    template <typename... Columns>
+    class AsyncCursor;
+
+    /**
+     * A connection that is used by a worker thread of its own.
+     *
+     * Requests are queued and executed one after the other on the worker thread, the
+     * calling threads get a std::future of the outcome and never touch sqlite
+     * themselves. Exceptions thrown while executing a request are rethrown by the
+     * future.
+     */
+    class CQLITE_EXPORT AsyncDatabase
+    {
+      public:
+        using Task = std::function<void (Database&)>;
+
+      public:
+        explicit AsyncDatabase (const std::string&,
+            std::uint8_t = Database::ReadWrite | Database::Create | Database::NoMutex);
+        ~AsyncDatabase ();
+
+        AsyncDatabase (const AsyncDatabase&) = delete;
+        AsyncDatabase& operator= (const AsyncDatabase&) = delete;
+
+        template <typename Function>
+        std::future<std::invoke_result_t<Function, Database&>> submit (Function&&);
+
+        std::future<void> execute (std::string);
+
+        template <typename... Columns, typename... Parameters>
+        std::future<std::vector<std::tuple<Columns...>>> fetch (
+            std::string, Parameters...);
+
+        template <typename... Columns, typename... Parameters>
+        AsyncCursor<Columns...> cursor (std::string, Parameters...);
+
+      private:
+        template <typename... Columns>
+        friend class AsyncCursor;
+
+        void post (Task);
+        void run ();
+
+      private:
+        Database db_;
+
+        std::mutex mutex_;
+        std::condition_variable posted_;
+        std::deque<Task> tasks_;
+        bool stopping_;
+
+        std::thread worker_;
+    };
+
+    /**
+     * The rows of a query that are read in chunks on the worker thread of an
+     * AsyncDatabase.
+     *
+     * The statement stays prepared on the worker until the cursor is destroyed, the
+     * cursor must not outlive its database.
+     * @see AsyncDatabase::cursor
+     */
+    template <typename... Columns>
+    class AsyncCursor
+    {
+      public:
+        using Row = std::tuple<Columns...>;
+
+      public:
+        ~AsyncCursor ();
+
+        AsyncCursor (const AsyncCursor&) = delete;
+        AsyncCursor& operator= (const AsyncCursor&) = delete;
+        AsyncCursor (AsyncCursor&&) = default;
+        AsyncCursor& operator= (AsyncCursor&&);
+
+        std::future<std::vector<Row>> next (std::size_t);
+
+      private:
+        friend class AsyncDatabase;
+
+        struct State
+        {
+            std::string sql;
+            std::function<void (Statement&)> bind;
+            std::optional<Statement> statement;
+            std::optional<Rows<Columns...>> rows;
+        };
+
+        AsyncCursor (AsyncDatabase*, std::shared_ptr<State>);
+
+        void release ();
+
+      private:
+        AsyncDatabase* db_;
+        std::shared_ptr<State> state_;
+    };
+
+    /**
+     * Queues the given function, which is called with the connection on the worker
+     * thread.
+     * @param function the function to call
+     * @return the future of its return value
+     */
+    template <typename Function>
+    inline std::future<std::invoke_result_t<Function, Database&>> AsyncDatabase::submit (
+        Function&& function)
+    {
+        using Value = std::invoke_result_t<Function, Database&>;
+
+        auto task = std::make_shared<std::packaged_task<Value (Database&)>> (
+            std::forward<Function> (function));
+        std::future<Value> future = task->get_future ();
+
+        post ([task] (Database& db) { (*task) (db); });
+
+        return future;
+    }
+
+    /**
+     * Queues the given query and reads all of its rows into tuples of the given column
+     * types, e.g.
+     * @code
+
+     cqlite::AsyncDatabase db {"things.db"};
+
+     auto things = db.fetch<std::int64_t, std::string> (
+         "SELECT id, name FROM things WHERE age > ?1", 42);
+     ...
+     for (const auto& [id, name] : things.get ()) {
+         ...
+     }
+
+     @endcode
+     * The parameters are bound on the worker thread, the values are copied into the
+     * request, memory they refer to has to stay valid until the future is ready.
+     * @param sql the query
+     * @param parameters the values to bind to the parameters of the query
+     * @return the future of the rows
+     */
+    template <typename... Columns, typename... Parameters>
+    inline std::future<std::vector<std::tuple<Columns...>>> AsyncDatabase::fetch (
+        std::string sql, Parameters... parameters)
+    {
+        static_assert (detail::AreOwning<Columns...>,
+            "Views do not survive the step to the next row, use a cursor instead");
+
+        return submit ([sql = std::move (sql), parameters...] (Database& db) {
+            Statement statement = db.prepare (sql);
+            (statement << ... << parameters);
+
+            std::vector<std::tuple<Columns...>> result;
+
+            for (const auto& row : statement.rows<Columns...> ()) {
+                result.push_back (row);
+            }
+
+            return result;
+        });
+    }
+
+    /**
+     * Creates a cursor over the rows of the given query, the query is prepared and
+     * executed on the worker thread with the first request of rows.
+     * @param sql the query
+     * @param parameters the values to bind to the parameters of the query, see fetch
+     * @return the cursor
+     */
+    template <typename... Columns, typename... Parameters>
+    inline AsyncCursor<Columns...> AsyncDatabase::cursor (
+        std::string sql, Parameters... parameters)
+    {
+        static_assert (detail::AreOwning<Columns...>,
+            "Views do not survive the step to the next row");
+
+        using State = typename AsyncCursor<Columns...>::State;
+
+        auto state = std::make_shared<State> (State {std::move (sql),
+            [parameters...] (Statement& statement) { (statement << ... << parameters); },
+            std::nullopt, std::nullopt});
+
+        return AsyncCursor<Columns...> {this, std::move (state)};
+    }
+
+    template <typename... Columns>
+    inline AsyncCursor<Columns...>::AsyncCursor (
+        AsyncDatabase* db, std::shared_ptr<State> state) :
+        db_ {db},
+        state_ {std::move (state)}
+    {}
+
+    /**
+     * Hands the statement back to the worker thread, where it is finalized.
+     */
+    template <typename... Columns>
+    inline AsyncCursor<Columns...>::~AsyncCursor ()
+    {
+        release ();
+    }
+
+    /**
+     * Takes over the query of the given cursor, the statement of this cursor is
+     * handed back to the worker thread of its database, where it is finalized.
+     * @param other the cursor to move from, it has no query anymore
+     * @return this cursor
+     */
+    template <typename... Columns>
+    inline AsyncCursor<Columns...>& AsyncCursor<Columns...>::operator= (
+        AsyncCursor&& other)
+    {
+        if (this != &other) {
+            release ();
+
+            db_ = other.db_;
+            state_ = std::move (other.state_);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Hands the statement of this cursor back to the worker thread, where it is
+     * finalized, without waiting for it.
+     */
+    template <typename... Columns>
+    inline void AsyncCursor<Columns...>::release ()
+    {
+        if (state_) {
+            db_->post (
+                [state = std::move (state_)] (Database&) mutable { state.reset (); });
+        }
+    }
+
+    /**
+     * Requests the next rows.
+     * @param count the maximal number of rows to read
+     * @return the future of the rows, which has less than the requested number of rows
+     * only at the end of the result
+     * @throws StatementError if the cursor has been moved from
+     */
+    template <typename... Columns>
+    inline std::future<std::vector<typename AsyncCursor<Columns...>::Row>>
+        AsyncCursor<Columns...>::next (std::size_t count)
+    {
+        if (! state_) {
+            throw StatementError {"The cursor has no query, it has been moved from"};
+        }
+
+        return db_->submit ([state = state_, count] (Database& db) {
+            if (! state->rows) {
+                state->statement.emplace (db.prepare (state->sql));
+                state->bind (*state->statement);
+                state->rows.emplace (state->statement->template rows<Columns...> ());
+            }
+
+            std::vector<Row> result;
+            result.reserve (count);
+
+            for (auto row = state->rows->begin ();
+                 result.size () < count && row != state->rows->end ();) {
+                result.push_back (*row);
+                ++row;
+            }
+
+            return result;
+        });
+    }
+} // namespace cqlite
+
+#endif /* CQLITE_ASYNC_INC */
@@ -0,0 +1,235 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * backup.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/backup.hpp>
+#include <cqlite/code.hpp>
+
+#include <sqlite3.h>
+
+#include <utility>
+
+namespace cqlite {
+
+    BackupError::BackupError (const std::string& what) : Error {what} {}
+
+    BackupError::BackupError (const char* what) : Error {what} {}
+
+    /**
+     * Prepares the copy of the given database into another one, whose contents are
+     * replaced.
+     * @param source the database to copy
+     * @param destination the database to copy to, which must not be used until the
+     * backup is done
+     * @param schema the name of the schema to copy in both databases
+     * @throws BackupError if the backup cannot be started
+     */
+    Backup::Backup (Database& source, Database& destination, const std::string& schema) :
+        target_ {},
+        backup_ {nullptr},
+        remaining_ {0},
+        total_ {0},
+        done_ {false},
+        cancelled_ {false},
+        running_ {false},
+        worker_ {}
+    {
+        open (source, destination, schema);
+    }
+
+    /**
+     * Prepares the copy of the given database into a file, which is created or whose
+     * contents are replaced.
+     * @param source the database to copy
+     * @param path the path to the file to copy to
+     * @param schema the name of the schema to copy
+     * @throws DbError if the file cannot be opened
+     * @throws BackupError if the backup cannot be started
+     */
+    Backup::Backup (
+        Database& source, const std::string& path, const std::string& schema) :
+        target_ {std::in_place, path,
+            Database::ReadWrite | Database::Create | Database::NoMutex},
+        backup_ {nullptr},
+        remaining_ {0},
+        total_ {0},
+        done_ {false},
+        cancelled_ {false},
+        running_ {false},
+        worker_ {}
+    {
+        open (source, *target_, schema);
+    }
+
+    /**
+     * Stops a running background copy and releases the backup, an incomplete copy
+     * is left as it is.
+     */
+    Backup::~Backup ()
+    {
+        cancel ();
+        join ();
+
+        sqlite3_backup_finish (backup_);
+    }
+
+    /**
+     * Copies the given number of pages.
+     * @param pages the number of pages to copy, 0 copies all remaining pages
+     * @return true iff the copy is complete
+     * @throws BackupError if copying fails
+     */
+    bool Backup::step (std::size_t pages)
+    {
+        if (done_) {
+            return true;
+        }
+
+        const int result
+            = sqlite3_backup_step (backup_, pages == 0 ? -1 : static_cast<int> (pages));
+
+        remaining_ = static_cast<std::size_t> (sqlite3_backup_remaining (backup_));
+        total_ = static_cast<std::size_t> (sqlite3_backup_pagecount (backup_));
+
+        if (result == SQLITE_DONE) {
+            done_ = true;
+        }
+        // A busy or locked source is simply tried again with the next step.
+        else if (result != SQLITE_OK && (result & 0xff) != SQLITE_BUSY
+                 && ! Code::isLocked (result)) {
+            throw BackupError {sqlite3_errstr (result)};
+        }
+
+        return done_;
+    }
+
+    /**
+     * Copies step by step until the copy is complete or cancelled, a cancelled copy
+     * is continued.
+     * @param pagesPerStep the number of pages copied per step, which bounds the time
+     * the source is locked
+     * @param pause the time to wait between two steps, giving writers room
+     * @param progress called after every step
+     * @throws BackupError if copying fails or the copy is already running
+     */
+    void Backup::run (std::size_t pagesPerStep, std::chrono::milliseconds pause,
+        const ProgressHandler& progress)
+    {
+        if (running_.exchange (true)) {
+            throw BackupError {"The backup is already running"};
+        }
+
+        struct Stopped
+        {
+            std::atomic<bool>& running;
+            ~Stopped () { running = false; }
+        } stopped {running_};
+
+        cancelled_ = false;
+        copy (pagesPerStep, pause, progress);
+    }
+
+    /**
+     * Runs the copy on a background thread, see run.
+     * The cancellation is reset here rather than on the background thread, so a copy
+     * cancelled right after starting is not continued anyway.
+     * @param pagesPerStep the number of pages copied per step
+     * @param pause the time to wait between two steps
+     * @param progress called after every step on the background thread
+     * @return the future that becomes ready when the copy is complete or cancelled,
+     * or that holds the error that stopped it
+     * @throws BackupError if the copy is already running
+     */
+    std::future<void> Backup::start (std::size_t pagesPerStep,
+        std::chrono::milliseconds pause, ProgressHandler progress)
+    {
+        if (running_.exchange (true)) {
+            throw BackupError {"The backup is already running"};
+        }
+
+        join ();
+        cancelled_ = false;
+
+        std::packaged_task<void ()> task {
+            [this, pagesPerStep, pause, progress = std::move (progress)] {
+                struct Stopped
+                {
+                    std::atomic<bool>& running;
+                    ~Stopped () { running = false; }
+                } stopped {running_};
+
+                copy (pagesPerStep, pause, progress);
+            }};
+        std::future<void> future = task.get_future ();
+
+        try {
+            worker_ = std::thread {std::move (task)};
+        }
+        catch (...) {
+            running_ = false;
+            throw;
+        }
+
+        return future;
+    }
+
+    /**
+     * Lets a running copy stop after its current step, it can be continued later on.
+     */
+    void Backup::cancel () { cancelled_ = true; }
+
+    void Backup::open (Database& source, Database& destination, const std::string& schema)
+    {
+        backup_ = sqlite3_backup_init (
+            destination.db_, schema.c_str (), source.db_, schema.c_str ());
+
+        if (! backup_) {
+            throw BackupError {sqlite3_errmsg (destination.db_)};
+        }
+    }
+
+    void Backup::copy (std::size_t pagesPerStep, std::chrono::milliseconds pause,
+        const ProgressHandler& progress)
+    {
+        while (! cancelled_ && ! step (pagesPerStep)) {
+            if (progress) {
+                progress (this->progress ());
+            }
+
+            if (pause.count () > 0) {
+                std::this_thread::sleep_for (pause);
+            }
+        }
+
+        if (progress && done_) {
+            progress (this->progress ());
+        }
+    }
+
+    void Backup::join ()
+    {
+        if (worker_.joinable ()) {
+            worker_.join ();
+        }
+    }
+} // namespace cqlite
@@ -0,0 +1,132 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * backup.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_BACKUP_INC
+#define CQLITE_BACKUP_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/error.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <optional>
+#include <string>
+#include <thread>
+
+struct sqlite3_backup;
+
+namespace cqlite {
+
+    class CQLITE_EXPORT BackupError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit BackupError (const std::string&);
+        explicit BackupError (const char*);
+    };
+
+    /**
+     * An online copy of a database, which is taken a number of pages at a time.
+     *
+     * Between the steps the source is not locked, so that writers are only blocked
+     * for the duration of one step. If the source is written to by another connection
+     * in between, the copy starts over; changes made through the source connection
+     * itself are carried over to the copy instead.
+     *
+     * The source connection is used by the background thread while a backup runs in
+     * the background, so it should be a connection of its own or opened with
+     * Database::FullMutex.
+     */
+    class CQLITE_EXPORT Backup
+    {
+      public:
+        struct Progress
+        {
+            /** The number of pages still to copy */
+            std::size_t remaining;
+            /** The number of pages of the source */
+            std::size_t total;
+        };
+
+        using ProgressHandler = std::function<void (const Progress&)>;
+
+      public:
+        Backup (Database&, Database&, const std::string& = "main");
+        Backup (Database&, const std::string&, const std::string& = "main");
+        ~Backup ();
+
+        Backup (const Backup&) = delete;
+        Backup& operator= (const Backup&) = delete;
+
+        bool step (std::size_t);
+        void run (std::size_t, std::chrono::milliseconds = std::chrono::milliseconds {0},
+            const ProgressHandler& = {});
+        std::future<void> start (std::size_t,
+            std::chrono::milliseconds = std::chrono::milliseconds {10},
+            ProgressHandler = {});
+        void cancel ();
+
+        Progress progress () const;
+        bool done () const;
+
+      private:
+        void open (Database&, Database&, const std::string&);
+        void copy (std::size_t, std::chrono::milliseconds, const ProgressHandler&);
+        void join ();
+
+      private:
+        std::optional<Database> target_;
+        sqlite3_backup* backup_;
+
+        std::atomic<std::size_t> remaining_;
+        std::atomic<std::size_t> total_;
+        std::atomic<bool> done_;
+        std::atomic<bool> cancelled_;
+        std::atomic<bool> running_;
+
+        std::thread worker_;
+    };
+
+    /**
+     * How far the copy has come, as of the last step.
+     * @return the number of remaining and total pages
+     */
+    inline Backup::Progress Backup::progress () const
+    {
+        return Progress {remaining_.load (), total_.load ()};
+    }
+
+    /**
+     * Whether the copy is complete.
+     * @return true iff all pages have been copied
+     */
+    inline bool Backup::done () const { return done_.load (); }
+} // namespace cqlite
+
+#endif /* CQLITE_BACKUP_INC */
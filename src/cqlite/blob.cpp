@@ -0,0 +1,291 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * blob.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/blob.hpp>
+
+#include <sqlite3.h>
+
+#include <algorithm>
+
+namespace cqlite {
+
+    BlobError::BlobError (const std::string& what) : Error {what} {}
+
+    BlobError::BlobError (const char* what) : Error {what} {}
+
+    /**
+     * Opens the blob in the given row and column.
+     * @param db the database
+     * @param table the name of the table
+     * @param column the name of the column
+     * @param rowid the rowid of the row
+     * @param access whether the blob is only read or also written
+     * @param chunkSize the number of bytes read or written at once
+     * @param schema the name of the schema the table is in
+     * @throws BlobError if the blob cannot be opened
+     */
+    BlobBuffer::BlobBuffer (Database& db, const std::string& table,
+        const std::string& column, std::int64_t rowid, Access access,
+        std::size_t chunkSize, const std::string& schema) :
+        db_ {db.db_},
+        blob_ {nullptr},
+        size_ {0},
+        writable_ {access == Access::ReadWrite},
+        offset_ {0},
+        buffer_ (std::max<std::size_t> (chunkSize, 1))
+    {
+        int result = sqlite3_blob_open (db_, schema.c_str (), table.c_str (),
+            column.c_str (), rowid, writable_ ? 1 : 0, &blob_);
+
+        if (result != SQLITE_OK) {
+            std::string errmsg {sqlite3_errmsg (db_)};
+            sqlite3_blob_close (blob_);
+
+            throw BlobError {errmsg};
+        }
+
+        size_ = static_cast<std::size_t> (sqlite3_blob_bytes (blob_));
+    }
+
+    /**
+     * Writes the pending bytes and closes the blob.
+     */
+    BlobBuffer::~BlobBuffer ()
+    {
+        flush ();
+        sqlite3_blob_close (blob_);
+    }
+
+    /**
+     * Moves to the blob in another row of the same table and column, which is faster
+     * than opening a new buffer.
+     * @param rowid the rowid of the row
+     * @throws BlobError if the pending bytes cannot be written or the blob cannot be
+     * opened
+     */
+    void BlobBuffer::reopen (std::int64_t rowid)
+    {
+        if (! flush ()) {
+            throw BlobError {sqlite3_errmsg (db_)};
+        }
+
+        int result = sqlite3_blob_reopen (blob_, rowid);
+
+        setg (nullptr, nullptr, nullptr);
+        setp (nullptr, nullptr);
+        offset_ = 0;
+        size_ = 0;
+
+        if (result != SQLITE_OK) {
+            throw BlobError {sqlite3_errmsg (db_)};
+        }
+
+        size_ = static_cast<std::size_t> (sqlite3_blob_bytes (blob_));
+    }
+
+    /**
+     * Reads the next chunk.
+     * @return the next byte or eof at the end of the blob
+     * @throws BlobError if the pending bytes cannot be written or the chunk cannot be
+     * read, e.g. because the row has been changed meanwhile, the stream reports it with
+     * its badbit
+     */
+    BlobBuffer::int_type BlobBuffer::underflow ()
+    {
+        const std::size_t from = position ();
+
+        if (! flush ()) {
+            throw BlobError {sqlite3_errmsg (db_)};
+        }
+
+        if (from >= size_) {
+            return traits_type::eof ();
+        }
+
+        const std::size_t count = std::min (buffer_.size (), size_ - from);
+
+        if (sqlite3_blob_read (blob_, buffer_.data (), static_cast<int> (count),
+                static_cast<int> (from))
+            != SQLITE_OK) {
+            throw BlobError {sqlite3_errmsg (db_)};
+        }
+
+        offset_ = from;
+        setg (buffer_.data (), buffer_.data (), buffer_.data () + count);
+
+        return traits_type::to_int_type (*gptr ());
+    }
+
+    /**
+     * Writes the buffered chunk and starts the next one.
+     * @param c the byte that did not fit anymore
+     * @return c or eof at the end of the blob or if it cannot be written
+     */
+    BlobBuffer::int_type BlobBuffer::overflow (int_type c)
+    {
+        const std::size_t from = position ();
+
+        if (! writable_ || ! flush () || from >= size_) {
+            return traits_type::eof ();
+        }
+
+        const std::size_t count = std::min (buffer_.size (), size_ - from);
+
+        offset_ = from;
+        setg (nullptr, nullptr, nullptr);
+        setp (buffer_.data (), buffer_.data () + count);
+
+        if (traits_type::eq_int_type (c, traits_type::eof ())) {
+            return traits_type::not_eof (c);
+        }
+
+        *pptr () = traits_type::to_char_type (c);
+        pbump (1);
+
+        return c;
+    }
+
+    /**
+     * Writes the buffered bytes.
+     * @return 0 on success, -1 if the bytes cannot be written
+     */
+    int BlobBuffer::sync () { return flush () ? 0 : -1; }
+
+    /**
+     * Moves to another position within the blob.
+     * @param offset the offset relative to the given direction
+     * @param direction where the offset is relative to
+     * @return the new position or -1 if it lies outside the blob
+     */
+    BlobBuffer::pos_type BlobBuffer::seekoff (
+        off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode)
+    {
+        off_type base = 0;
+
+        if (direction == std::ios_base::cur) {
+            base = static_cast<off_type> (position ());
+        }
+        else if (direction == std::ios_base::end) {
+            base = static_cast<off_type> (size_);
+        }
+
+        const off_type target = base + offset;
+
+        if (target < 0 || target > static_cast<off_type> (size_) || ! flush ()) {
+            return pos_type (off_type (-1));
+        }
+
+        // Telling the position must not throw away the buffered chunk.
+        if (static_cast<std::size_t> (target) != position ()) {
+            moveTo (static_cast<std::size_t> (target));
+        }
+
+        return pos_type (target);
+    }
+
+    /**
+     * Moves to another position within the blob.
+     * @param position the position from the beginning of the blob
+     * @param mode unused, reading and writing share the position
+     * @return the new position or -1 if it lies outside the blob
+     */
+    BlobBuffer::pos_type BlobBuffer::seekpos (
+        pos_type position, std::ios_base::openmode mode)
+    {
+        return seekoff (off_type (position), std::ios_base::beg, mode);
+    }
+
+    /**
+     * The position of the next byte read or written.
+     * At most one of the get and the put area is in use at a time.
+     */
+    std::size_t BlobBuffer::position () const
+    {
+        if (pbase ()) {
+            return offset_ + static_cast<std::size_t> (pptr () - pbase ());
+        }
+
+        if (eback ()) {
+            return offset_ + static_cast<std::size_t> (gptr () - eback ());
+        }
+
+        return offset_;
+    }
+
+    /**
+     * Writes the bytes of the put area, if any, and leaves the position behind them.
+     */
+    bool BlobBuffer::flush ()
+    {
+        if (! pbase ()) {
+            return true;
+        }
+
+        const std::size_t count = static_cast<std::size_t> (pptr () - pbase ());
+        int result = count == 0 ? SQLITE_OK
+                                : sqlite3_blob_write (blob_, pbase (),
+                                    static_cast<int> (count), static_cast<int> (offset_));
+
+        if (result != SQLITE_OK) {
+            return false;
+        }
+
+        moveTo (offset_ + count);
+
+        return true;
+    }
+
+    void BlobBuffer::moveTo (std::size_t position)
+    {
+        offset_ = position;
+        setg (nullptr, nullptr, nullptr);
+        setp (nullptr, nullptr);
+    }
+
+    /**
+     * Opens a stream on the blob in the given row and column.
+     * @see BlobBuffer::BlobBuffer
+     * @throws BlobError if the blob cannot be opened
+     */
+    BlobStream::BlobStream (Database& db, const std::string& table,
+        const std::string& column, std::int64_t rowid, Access access,
+        std::size_t chunkSize, const std::string& schema) :
+        std::iostream {nullptr},
+        buffer_ {db, table, column, rowid, access, chunkSize, schema}
+    {
+        rdbuf (&buffer_);
+    }
+
+    /**
+     * Moves the stream to the blob in another row of the same table and column.
+     * The state of the stream is cleared.
+     * @param rowid the rowid of the row
+     * @throws BlobError if the blob cannot be opened
+     */
+    void BlobStream::reopen (std::int64_t rowid)
+    {
+        buffer_.reopen (rowid);
+        clear ();
+    }
+} // namespace cqlite
@@ -0,0 +1,161 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * blob.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_BLOB_INC
+#define CQLITE_BLOB_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_blob;
+
+namespace cqlite {
+
+    class CQLITE_EXPORT BlobError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit BlobError (const std::string&);
+        explicit BlobError (const char*);
+    };
+
+    /**
+     * A stream buffer over a blob stored within the database, which is read and written
+     * incrementally, one chunk at a time.
+     *
+     * The size of a blob cannot be changed through the buffer, writing stops at its
+     * end. In order to stream a new blob, a row is inserted with a ZeroBlob of the
+     * final size first, which sqlite allocates without materializing it in memory.
+     * Any change of the row by other means than this buffer invalidates it, after that
+     * it only fails until it is reopened.
+     */
+    class CQLITE_EXPORT BlobBuffer : public std::streambuf
+    {
+      public:
+        enum class Access
+        {
+            ReadOnly,
+            ReadWrite
+        };
+
+        /** The default size of the chunks read and written at once. */
+        static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+      public:
+        BlobBuffer (Database&, const std::string&, const std::string&, std::int64_t,
+            Access = Access::ReadOnly, std::size_t = DefaultChunkSize,
+            const std::string& = "main");
+        ~BlobBuffer () override;
+
+        BlobBuffer (const BlobBuffer&) = delete;
+        BlobBuffer& operator= (const BlobBuffer&) = delete;
+
+        void reopen (std::int64_t);
+
+        std::size_t size () const;
+
+      protected:
+        int_type underflow () override;
+        int_type overflow (int_type) override;
+        int sync () override;
+
+        pos_type seekoff (off_type, std::ios_base::seekdir,
+            std::ios_base::openmode = std::ios_base::in | std::ios_base::out) override;
+        pos_type seekpos (pos_type,
+            std::ios_base::openmode = std::ios_base::in | std::ios_base::out) override;
+
+      private:
+        std::size_t position () const;
+        bool flush ();
+        void moveTo (std::size_t);
+
+      private:
+        sqlite3* db_;
+        sqlite3_blob* blob_;
+        std::size_t size_;
+        bool writable_;
+
+        /** The offset within the blob of the first byte of the buffer */
+        std::size_t offset_;
+        std::vector<char> buffer_;
+    };
+
+    /**
+     * An iostream over a blob stored within the database, e.g.
+     * @code
+
+     cqlite::Statement insert = db.prepare ("INSERT INTO files (data) VALUES (?1)");
+     insert << cqlite::ZeroBlob {size};
+     insert.execute ();
+
+     cqlite::BlobStream file {db, "files", "data", db.lastInsertId (),
+         cqlite::BlobStream::Access::ReadWrite};
+
+     file << source.rdbuf ();
+
+     @endcode
+     * @see BlobBuffer
+     */
+    class CQLITE_EXPORT BlobStream : public std::iostream
+    {
+      public:
+        using Access = BlobBuffer::Access;
+
+      public:
+        BlobStream (Database&, const std::string&, const std::string&, std::int64_t,
+            Access = Access::ReadOnly, std::size_t = BlobBuffer::DefaultChunkSize,
+            const std::string& = "main");
+
+        void reopen (std::int64_t);
+
+        std::size_t size () const;
+
+      private:
+        BlobBuffer buffer_;
+    };
+
+    /**
+     * The size of the blob.
+     * @return the number of bytes
+     */
+    inline std::size_t BlobBuffer::size () const { return size_; }
+
+    /**
+     * The size of the blob.
+     * @return the number of bytes
+     */
+    inline std::size_t BlobStream::size () const { return buffer_.size (); }
+} // namespace cqlite
+
+#endif /* CQLITE_BLOB_INC */
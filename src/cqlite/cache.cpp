@@ -0,0 +1,161 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * cache.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/cache.hpp>
+
+#include <sqlite3.h>
+
+#include <iterator>
+
+namespace cqlite {
+
+    /**
+     * Creates an empty cache.
+     * @param capacity the maximal number of statements kept
+     */
+    StatementCache::StatementCache (std::size_t capacity) :
+        capacity_ {capacity},
+        hits_ {0},
+        misses_ {0},
+        entries_ {},
+        bySql_ {},
+        byHandle_ {}
+    {}
+
+    /**
+     * Finalizes all idle statements.
+     * Leased statements are finalized by their Statement instances, they cannot be
+     * handed back anymore.
+     */
+    StatementCache::~StatementCache ()
+    {
+        for (const Entry& entry : entries_) {
+            if (! entry.leased) {
+                sqlite3_finalize (entry.stmt);
+            }
+        }
+    }
+
+    /**
+     * Leases the idle statement that was compiled from the given sql.
+     * @param sql the sql text of the statement
+     * @return the statement or null if there is no idle statement for the given sql
+     */
+    sqlite3_stmt* StatementCache::checkout (const std::string& sql)
+    {
+        auto at = bySql_.find (sql);
+
+        if (at == bySql_.end () || at->second->leased) {
+            ++misses_;
+            return nullptr;
+        }
+
+        ++hits_;
+
+        Entries::iterator entry = at->second;
+        entry->leased = true;
+        entries_.splice (entries_.begin (), entries_, entry);
+
+        return entry->stmt;
+    }
+
+    /**
+     * Takes back a leased statement.
+     * The statement is reset and its bindings are cleared, so that the next lease
+     * starts from scratch.
+     * @param stmt the statement that is no longer used
+     * @return true iff the statement belongs to this cache, otherwise the caller
+     * remains responsible for it
+     */
+    bool StatementCache::checkin (sqlite3_stmt* stmt)
+    {
+        auto at = byHandle_.find (stmt);
+
+        if (at == byHandle_.end ()) {
+            return false;
+        }
+
+        sqlite3_reset (stmt);
+        sqlite3_clear_bindings (stmt);
+
+        at->second->leased = false;
+
+        return true;
+    }
+
+    /**
+     * Adds a freshly compiled statement as leased.
+     * Least recently used idle statements are evicted to make room for it.
+     * @param sql the sql text the statement was compiled from
+     * @param stmt the statement
+     * @return true iff the statement has been taken over, which fails if there is
+     * already a statement for this sql or if all the cached statements are leased
+     */
+    bool StatementCache::insert (const std::string& sql, sqlite3_stmt* stmt)
+    {
+        if (capacity_ == 0 || bySql_.count (sql) != 0) {
+            return false;
+        }
+
+        while (entries_.size () >= capacity_) {
+            if (! evict ()) {
+                return false;
+            }
+        }
+
+        entries_.push_front (Entry {sql, stmt, true});
+        bySql_.emplace (sql, entries_.begin ());
+        byHandle_.emplace (stmt, entries_.begin ());
+
+        return true;
+    }
+
+    /**
+     * The current usage of this cache.
+     * @return the number of hits, misses, cached statements and the capacity
+     */
+    StatementCache::Stats StatementCache::stats () const
+    {
+        return Stats {hits_, misses_, entries_.size (), capacity_};
+    }
+
+    bool StatementCache::evict ()
+    {
+        for (auto at = entries_.rbegin (); at != entries_.rend (); ++at) {
+            if (! at->leased) {
+                Entries::iterator entry = std::next (at).base ();
+
+                sqlite3_finalize (entry->stmt);
+
+                bySql_.erase (entry->sql);
+                byHandle_.erase (entry->stmt);
+                entries_.erase (entry);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace cqlite
@@ -0,0 +1,95 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * cache.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_CACHE_INC
+#define CQLITE_CACHE_INC
+
+#include <cqlite/cqlite_export.hpp>
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+struct sqlite3_stmt;
+
+namespace cqlite {
+
+    /**
+     * A bounded, least recently used set of prepared statements of one connection,
+     * keyed by their sql text.
+     *
+     * A statement is either idle within the cache or leased to exactly one Statement
+     * instance, which hands it back when it is destroyed. Only idle statements are
+     * evicted.
+     */
+    class CQLITE_EXPORT StatementCache
+    {
+      public:
+        struct Stats
+        {
+            std::size_t hits;
+            std::size_t misses;
+            std::size_t size;
+            std::size_t capacity;
+        };
+
+      public:
+        explicit StatementCache (std::size_t);
+        ~StatementCache ();
+
+        StatementCache (const StatementCache&) = delete;
+        StatementCache& operator= (const StatementCache&) = delete;
+
+        sqlite3_stmt* checkout (const std::string&);
+        bool checkin (sqlite3_stmt*);
+        bool insert (const std::string&, sqlite3_stmt*);
+
+        Stats stats () const;
+
+      private:
+        struct Entry
+        {
+            std::string sql;
+            sqlite3_stmt* stmt;
+            bool leased;
+        };
+
+        using Entries = std::list<Entry>;
+
+        bool evict ();
+
+      private:
+        std::size_t capacity_;
+        std::size_t hits_;
+        std::size_t misses_;
+
+        /** Most recently used first */
+        Entries entries_;
+        std::unordered_map<std::string, Entries::iterator> bySql_;
+        std::unordered_map<sqlite3_stmt*, Entries::iterator> byHandle_;
+    };
+} // namespace cqlite
+
+#endif /* CQLITE_CACHE_INC */
@@ -48,5 +48,17 @@ namespace cqlite {
 
         return success;
     }
+
+    /**
+     * Whether the given sqlite return value reports a table locked by a connection that
+     * shares the same cache.
+     * @param code the return value from the questioned sqlite3 function call
+     * @return true iff the given return value is SQLITE_LOCKED or one of its extended
+     * codes
+     */
+    bool Code::isLocked (int code)
+    {
+        return (code & 0xff) == SQLITE_LOCKED;
+    }
 }
 
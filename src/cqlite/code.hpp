@@ -37,6 +37,7 @@ namespace cqlite {
         public:
             static bool isSuccess (int);
             static bool isError (int);
+            static bool isLocked (int);
     };
 
     /**
@@ -0,0 +1,188 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * columns.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/columns.hpp>
+
+#include <sqlite3.h>
+
+namespace cqlite {
+
+    ColumnBatch::Column::Column () :
+        type_ {Result::Type::Null},
+        integers_ {},
+        reals_ {},
+        offsets_ {},
+        bytes_ {},
+        nulls_ {}
+    {}
+
+    /**
+     * The text of the given row.
+     * @param row the row within the batch
+     * @return the text, which is valid as long as the batch is not refilled, or an empty
+     * view if this is no text or blob column
+     */
+    std::string_view ColumnBatch::Column::text (std::size_t row) const
+    {
+        if (offsets_.empty ()) {
+            return std::string_view {};
+        }
+
+        return std::string_view {bytes_.data () + offsets_[row],
+            offsets_[row + 1] - offsets_[row]};
+    }
+
+    /**
+     * The blob of the given row.
+     * @param row the row within the batch
+     * @return the blob, which is valid as long as the batch is not refilled, or an empty
+     * view if this is no text or blob column
+     */
+    BlobView ColumnBatch::Column::blob (std::size_t row) const
+    {
+        if (offsets_.empty ()) {
+            return BlobView {};
+        }
+
+        return BlobView {
+            bytes_.data () + offsets_[row], offsets_[row + 1] - offsets_[row]};
+    }
+
+    void ColumnBatch::Column::clear ()
+    {
+        type_ = Result::Type::Null;
+
+        integers_.clear ();
+        reals_.clear ();
+        offsets_.clear ();
+        bytes_.clear ();
+        nulls_.clear ();
+    }
+
+    void ColumnBatch::Column::append (sqlite3_stmt* stmt, int column, std::size_t row)
+    {
+        if (row % 64 == 0) {
+            nulls_.push_back (0);
+        }
+
+        const int storage = sqlite3_column_type (stmt, column);
+
+        if (storage == SQLITE_NULL) {
+            nulls_.back () |= std::uint64_t {1} << (row % 64);
+        }
+        else if (type_ == Result::Type::Null) {
+            adopt (storage == SQLITE_INTEGER ? Result::Type::Integer
+                    : storage == SQLITE_FLOAT ? Result::Type::Float
+                    : storage == SQLITE_TEXT  ? Result::Type::Text
+                                              : Result::Type::Blob,
+                row);
+        }
+
+        switch (type_) {
+
+            case Result::Type::Integer:
+                integers_.push_back (static_cast<std::int64_t> (
+                    storage == SQLITE_NULL ? 0 : sqlite3_column_int64 (stmt, column)));
+                break;
+            case Result::Type::Float:
+                reals_.push_back (
+                    storage == SQLITE_NULL ? 0.0 : sqlite3_column_double (stmt, column));
+                break;
+            case Result::Type::Text:
+            case Result::Type::Blob:
+                if (storage != SQLITE_NULL) {
+                    const void* data = type_ == Result::Type::Text
+                        ? static_cast<const void*> (sqlite3_column_text (stmt, column))
+                        : sqlite3_column_blob (stmt, column);
+                    const char* begin = static_cast<const char*> (data);
+                    const int size = sqlite3_column_bytes (stmt, column);
+
+                    bytes_.insert (bytes_.end (), begin, begin + size);
+                }
+                offsets_.push_back (bytes_.size ());
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /**
+     * Fixes the type of this column when its first non-null value is found in the given
+     * row, the preceding null rows get empty entries.
+     */
+    void ColumnBatch::Column::adopt (Result::Type type, std::size_t row)
+    {
+        type_ = type;
+
+        switch (type_) {
+
+            case Result::Type::Integer:
+                integers_.assign (row, 0);
+                break;
+            case Result::Type::Float:
+                reals_.assign (row, 0.0);
+                break;
+            case Result::Type::Text:
+            case Result::Type::Blob:
+                offsets_.assign (row + 1, 0);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    ColumnBatch::ColumnBatch () : rows_ {0}, columns_ {} {}
+
+    /**
+     * Removes all rows, the allocated memory is kept for reuse.
+     */
+    void ColumnBatch::clear ()
+    {
+        reset (columns_.size ());
+    }
+
+    void ColumnBatch::reset (std::size_t columns)
+    {
+        rows_ = 0;
+
+        if (columns_.size () != columns) {
+            columns_.resize (columns);
+        }
+
+        for (Column& column : columns_) {
+            column.clear ();
+        }
+    }
+
+    void ColumnBatch::append (sqlite3_stmt* stmt)
+    {
+        for (std::size_t column = 0; column < columns_.size (); ++column) {
+            columns_[column].append (stmt, static_cast<int> (column), rows_);
+        }
+
+        ++rows_;
+    }
+} // namespace cqlite
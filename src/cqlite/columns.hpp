@@ -0,0 +1,154 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * columns.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_COLUMNS_INC
+#define CQLITE_COLUMNS_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/result.hpp>
+#include <cqlite/view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+struct sqlite3_stmt;
+
+namespace cqlite {
+
+    /**
+     * A number of result rows stored column by column in contiguous arrays.
+     *
+     * Integer and float columns are kept as plain arrays, text and blob columns as one
+     * byte array with the offsets of the values (the value of row i spans
+     * [offsets[i], offsets[i + 1])). Every column has a bitmap with a set bit for every
+     * null row, the corresponding array entries are zero or empty. The arrays keep their
+     * capacity when the batch is refilled.
+     * @see Result::fetchColumns
+     */
+    class CQLITE_EXPORT ColumnBatch
+    {
+      public:
+        /**
+         * The values of one column.
+         *
+         * Its type is the storage class of the first non-null value within the batch,
+         * other values are converted to it by sqlite. A column with only null values
+         * has the type Result::Type::Null.
+         */
+        class CQLITE_EXPORT Column
+        {
+          public:
+            Column ();
+
+            Result::Type type () const;
+
+            const std::vector<std::int64_t>& integers () const;
+            const std::vector<double>& reals () const;
+            const std::vector<std::size_t>& offsets () const;
+            const std::vector<char>& bytes () const;
+            const std::vector<std::uint64_t>& nulls () const;
+
+            bool isNull (std::size_t) const;
+            std::string_view text (std::size_t) const;
+            BlobView blob (std::size_t) const;
+
+          private:
+            friend class ColumnBatch;
+
+            void clear ();
+            void append (sqlite3_stmt*, int, std::size_t);
+            void adopt (Result::Type, std::size_t);
+
+          private:
+            Result::Type type_;
+            std::vector<std::int64_t> integers_;
+            std::vector<double> reals_;
+            std::vector<std::size_t> offsets_;
+            std::vector<char> bytes_;
+            std::vector<std::uint64_t> nulls_;
+        };
+
+      public:
+        ColumnBatch ();
+
+        std::size_t rows () const;
+        std::size_t columns () const;
+
+        const Column& operator[] (std::size_t) const;
+
+        void clear ();
+
+      private:
+        friend class Result;
+
+        void reset (std::size_t);
+        void append (sqlite3_stmt*);
+
+      private:
+        std::size_t rows_;
+        std::vector<Column> columns_;
+    };
+
+    inline Result::Type ColumnBatch::Column::type () const { return type_; }
+
+    inline const std::vector<std::int64_t>& ColumnBatch::Column::integers () const
+    {
+        return integers_;
+    }
+
+    inline const std::vector<double>& ColumnBatch::Column::reals () const
+    {
+        return reals_;
+    }
+
+    inline const std::vector<std::size_t>& ColumnBatch::Column::offsets () const
+    {
+        return offsets_;
+    }
+
+    inline const std::vector<char>& ColumnBatch::Column::bytes () const { return bytes_; }
+
+    inline const std::vector<std::uint64_t>& ColumnBatch::Column::nulls () const
+    {
+        return nulls_;
+    }
+
+    inline bool ColumnBatch::Column::isNull (std::size_t row) const
+    {
+        return (nulls_[row / 64] >> (row % 64)) & 1;
+    }
+
+    inline std::size_t ColumnBatch::rows () const { return rows_; }
+
+    inline std::size_t ColumnBatch::columns () const { return columns_.size (); }
+
+    inline const ColumnBatch::Column& ColumnBatch::operator[] (std::size_t column) const
+    {
+        return columns_[column];
+    }
+} // namespace cqlite
+
+#endif /* CQLITE_COLUMNS_INC */
@@ -0,0 +1,313 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * contention.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/contention.hpp>
+#include <cqlite/cqlite_config.hpp>
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace cqlite {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Raises the given maximum to the given value, if it is larger.
+         */
+        void raise (std::atomic<std::int64_t>& maximum, std::int64_t value)
+        {
+            std::int64_t current = maximum.load (std::memory_order_relaxed);
+
+            while (current < value
+                   && ! maximum.compare_exchange_weak (
+                       current, value, std::memory_order_relaxed)) {
+            }
+        }
+    } // namespace
+
+    ContentionPolicy::ContentionPolicy () :
+        contentions_ {0}, retries_ {0}, failures_ {0}, waited_ {0}, longestWait_ {0}
+    {}
+
+    ContentionPolicy::~ContentionPolicy () = default;
+
+    /**
+     * The sqlite busy handler that forwards to the policy given as argument.
+     * @param policy the policy
+     * @param count the number of times the handler was invoked for the same lock
+     * @return non-zero to try again, zero to give up
+     */
+    int ContentionPolicy::busyHandler (void* policy, int count)
+    {
+        return static_cast<ContentionPolicy*> (policy)->busy (count) ? 1 : 0;
+    }
+
+    /**
+     * Waits as long as the policy decides for the given attempt.
+     * A thread waits for one lock at a time, so the start of the current wait is kept
+     * per thread, which allows for sharing a policy between connections.
+     * @param count the number of attempts so far, 0 when the lock is found held first
+     * @return true to try again, false to give up
+     */
+    bool ContentionPolicy::busy (int count)
+    {
+        thread_local Clock::time_point start;
+
+        const Clock::time_point now = Clock::now ();
+
+        if (count == 0) {
+            start = now;
+        }
+
+        const Duration waited = std::chrono::duration_cast<Duration> (now - start);
+        const std::optional<Duration> pause
+            = delay (static_cast<std::size_t> (count), waited);
+
+        if (! pause) {
+            if (count == 0) {
+                record (true, Duration::zero (), Duration::zero ());
+            }
+
+            recordFailure ();
+            return false;
+        }
+
+        std::this_thread::sleep_for (*pause);
+
+        const Clock::time_point end = Clock::now ();
+        record (count == 0, std::chrono::duration_cast<Duration> (end - now),
+            std::chrono::duration_cast<Duration> (end - start));
+
+        return true;
+    }
+
+    /**
+     * Called when a table of a shared cache is locked by another connection
+     * (SQLITE_LOCKED). By default, locked tables fail right away.
+     * @param db the connection that found the table locked
+     * @return true if the operation should be retried
+     */
+    bool ContentionPolicy::locked (sqlite3*) { return false; }
+
+    /**
+     * The statistics gathered since the creation or the last reset.
+     * They may be read while the policy is in use.
+     * @return the statistics
+     */
+    ContentionPolicy::Stats ContentionPolicy::stats () const
+    {
+        return Stats {
+            contentions_.load (std::memory_order_relaxed),
+            retries_.load (std::memory_order_relaxed),
+            failures_.load (std::memory_order_relaxed),
+            Duration {waited_.load (std::memory_order_relaxed)},
+            Duration {longestWait_.load (std::memory_order_relaxed)},
+        };
+    }
+
+    /**
+     * Clears the statistics.
+     */
+    void ContentionPolicy::resetStats ()
+    {
+        contentions_.store (0, std::memory_order_relaxed);
+        retries_.store (0, std::memory_order_relaxed);
+        failures_.store (0, std::memory_order_relaxed);
+        waited_.store (0, std::memory_order_relaxed);
+        longestWait_.store (0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Records one wait.
+     * @param first whether this is the first wait for a lock
+     * @param waited the duration of this wait
+     * @param total the time spent waiting for the lock so far, including this wait
+     */
+    void ContentionPolicy::record (bool first, Duration waited, Duration total)
+    {
+        if (first) {
+            contentions_.fetch_add (1, std::memory_order_relaxed);
+        }
+
+        if (waited > Duration::zero ()) {
+            retries_.fetch_add (1, std::memory_order_relaxed);
+            waited_.fetch_add (waited.count (), std::memory_order_relaxed);
+            raise (longestWait_, total.count ());
+        }
+    }
+
+    /**
+     * Records that the policy gave up waiting for a lock.
+     */
+    void ContentionPolicy::recordFailure ()
+    {
+        failures_.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    /**
+     * A policy that waits up to the given time for a lock.
+     * @param timeout the maximal time to wait for one lock
+     */
+    BusyTimeout::BusyTimeout (std::chrono::milliseconds timeout) : timeout_ {timeout} {}
+
+    std::optional<ContentionPolicy::Duration> BusyTimeout::delay (
+        std::size_t attempt, Duration waited)
+    {
+        // The delays sqlite3_busy_timeout uses.
+        static const std::chrono::milliseconds Delays[]
+            = {std::chrono::milliseconds {1}, std::chrono::milliseconds {2},
+                std::chrono::milliseconds {5}, std::chrono::milliseconds {10},
+                std::chrono::milliseconds {15}, std::chrono::milliseconds {20},
+                std::chrono::milliseconds {25}, std::chrono::milliseconds {25},
+                std::chrono::milliseconds {25}, std::chrono::milliseconds {50},
+                std::chrono::milliseconds {50}, std::chrono::milliseconds {100}};
+
+        const Duration left = timeout_ - waited;
+
+        if (left <= Duration::zero ()) {
+            return std::nullopt;
+        }
+
+        const Duration pause
+            = Delays[std::min (attempt, std::size (Delays) - std::size_t {1})];
+
+        return std::min (pause, left);
+    }
+
+    /**
+     * A policy that waits up to the given time for a lock, doubling its delays.
+     * @param timeout the maximal time to wait for one lock
+     * @param initial the delay before the first retry
+     * @param maximum the upper bound of a single delay
+     */
+    ExponentialBackoff::ExponentialBackoff (
+        std::chrono::milliseconds timeout, Duration initial, Duration maximum) :
+        timeout_ {timeout}, initial_ {initial}, maximum_ {maximum}
+    {}
+
+    std::optional<ContentionPolicy::Duration> ExponentialBackoff::delay (
+        std::size_t attempt, Duration waited)
+    {
+        thread_local std::minstd_rand random {std::random_device {}()};
+
+        const Duration left = timeout_ - waited;
+
+        if (left <= Duration::zero ()) {
+            return std::nullopt;
+        }
+
+        Duration pause = maximum_;
+
+        if (attempt < 32 && initial_.count () < (maximum_.count () >> attempt)) {
+            pause = initial_ * (std::int64_t {1} << attempt);
+        }
+
+        // Jitter: somewhere between half and the full delay.
+        std::uniform_int_distribution<Duration::rep> jitter {
+            pause.count () / 2, pause.count ()};
+
+        return std::min (Duration {jitter (random)}, left);
+    }
+
+    /**
+     * A policy that waits for table locks of a shared cache up to the given time.
+     * @param timeout the maximal time to wait for one lock
+     */
+    UnlockNotify::UnlockNotify (std::chrono::milliseconds timeout) :
+        BusyTimeout {timeout}, timeout_ {timeout}
+    {}
+
+    /**
+     * Blocks until the connection that holds the lock finishes its transaction.
+     * @param db the connection that found the table locked
+     * @return true if the lock was released in time, false if waiting would deadlock
+     * or the timeout expired
+     */
+    bool UnlockNotify::locked (sqlite3* db)
+    {
+#ifdef CQLITE_HAVE_UNLOCK_NOTIFY
+        struct Signal
+        {
+            std::mutex mutex;
+            std::condition_variable released;
+            bool fired = false;
+        };
+
+        struct Notify
+        {
+            static void callback (void** args, int count)
+            {
+                for (int i = 0; i < count; ++i) {
+                    Signal* signal = static_cast<Signal*> (args[i]);
+
+                    // Notified under the lock, the waiter may destroy the signal as
+                    // soon as the lock is released.
+                    std::lock_guard<std::mutex> lock {signal->mutex};
+                    signal->fired = true;
+                    signal->released.notify_all ();
+                }
+            }
+        };
+
+        Signal signal;
+        const Clock::time_point start = Clock::now ();
+
+        if (sqlite3_unlock_notify (db, &Notify::callback, &signal) != SQLITE_OK) {
+            // The blocking connection waits for this one, waiting would deadlock.
+            record (true, Duration::zero (), Duration::zero ());
+            recordFailure ();
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock {signal.mutex};
+        const bool released = signal.released.wait_for (
+            lock, timeout_, [&signal] { return signal.fired; });
+        lock.unlock ();
+
+        if (! released) {
+            // After cancelling, the callback is not invoked anymore.
+            sqlite3_unlock_notify (db, nullptr, nullptr);
+        }
+
+        const Duration waited
+            = std::chrono::duration_cast<Duration> (Clock::now () - start);
+        record (true, waited, waited);
+
+        if (! released) {
+            recordFailure ();
+        }
+
+        return released;
+#else
+        return ContentionPolicy::locked (db);
+#endif
+    }
+} // namespace cqlite
@@ -0,0 +1,161 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * contention.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_CONTENTION_INC
+#define CQLITE_CONTENTION_INC
+
+#include <cqlite/cqlite_export.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+struct sqlite3;
+
+namespace cqlite {
+
+    /**
+     * Decides how long a connection waits for a lock held by another connection.
+     *
+     * A policy is installed on a Database as its sqlite busy handler, so it is asked
+     * whenever sqlite finds the database file locked (SQLITE_BUSY), be it while
+     * preparing, executing or stepping. Policies may be shared between connections,
+     * their statistics then accumulate over all of them.
+     * @see Database::setContentionPolicy
+     */
+    class CQLITE_EXPORT ContentionPolicy
+    {
+      public:
+        using Duration = std::chrono::microseconds;
+
+        struct Stats
+        {
+            /** The number of times a lock was found to be held. */
+            std::uint64_t contentions;
+            /** The number of waits before trying again. */
+            std::uint64_t retries;
+            /** The number of times the policy gave up waiting. */
+            std::uint64_t failures;
+            /** The total time spent waiting. */
+            Duration waited;
+            /** The longest time spent waiting for one lock. */
+            Duration longestWait;
+        };
+
+      public:
+        virtual ~ContentionPolicy ();
+
+        ContentionPolicy (const ContentionPolicy&) = delete;
+        ContentionPolicy& operator= (const ContentionPolicy&) = delete;
+
+        bool busy (int);
+        virtual bool locked (sqlite3*);
+
+        Stats stats () const;
+        void resetStats ();
+
+        static int busyHandler (void*, int);
+
+      protected:
+        ContentionPolicy ();
+
+        /**
+         * How long to wait before the given attempt to acquire a lock.
+         * @param attempt the number of attempts so far, 0 on the first contention
+         * @param waited the time spent waiting for this lock so far
+         * @return the time to wait before the next attempt, nothing to give up
+         */
+        virtual std::optional<Duration> delay (std::size_t attempt, Duration waited) = 0;
+
+        void record (bool first, Duration waited, Duration total);
+        void recordFailure ();
+
+      private:
+        std::atomic<std::uint64_t> contentions_;
+        std::atomic<std::uint64_t> retries_;
+        std::atomic<std::uint64_t> failures_;
+        std::atomic<std::int64_t> waited_;
+        std::atomic<std::int64_t> longestWait_;
+    };
+
+    /**
+     * Waits up to a total timeout, in growing steps, like sqlite3_busy_timeout does,
+     * but with statistics.
+     */
+    class CQLITE_EXPORT BusyTimeout : public ContentionPolicy
+    {
+      public:
+        explicit BusyTimeout (std::chrono::milliseconds);
+
+      protected:
+        std::optional<Duration> delay (std::size_t, Duration) override;
+
+      private:
+        Duration timeout_;
+    };
+
+    /**
+     * Waits up to a total timeout with exponentially growing delays, randomized in
+     * order to keep contending connections from retrying in lockstep.
+     */
+    class CQLITE_EXPORT ExponentialBackoff : public ContentionPolicy
+    {
+      public:
+        ExponentialBackoff (std::chrono::milliseconds timeout,
+            Duration initial = std::chrono::milliseconds {1},
+            Duration maximum = std::chrono::milliseconds {100});
+
+      protected:
+        std::optional<Duration> delay (std::size_t, Duration) override;
+
+      private:
+        Duration timeout_;
+        Duration initial_;
+        Duration maximum_;
+    };
+
+    /**
+     * Waits for the connection holding a table lock of a shared cache to finish its
+     * transaction (sqlite3_unlock_notify), other contention is handled like with
+     * BusyTimeout.
+     *
+     * Table locks only exist between connections that share a cache, see
+     * Database::Shared. Unless sqlite is built with SQLITE_ENABLE_UNLOCK_NOTIFY, this
+     * policy behaves exactly like BusyTimeout.
+     */
+    class CQLITE_EXPORT UnlockNotify : public BusyTimeout
+    {
+      public:
+        explicit UnlockNotify (std::chrono::milliseconds);
+
+        bool locked (sqlite3*) override;
+
+      private:
+        std::chrono::milliseconds timeout_;
+    };
+} // namespace cqlite
+
+#endif /* CQLITE_CONTENTION_INC */
@@ -27,15 +27,25 @@
 
 #include <sqlite3.h>
 
-#include <chrono>
-#include <thread>
+#include <iterator>
+#include <string>
+#include <tuple>
 #include <utility>
 
 namespace cqlite {
 
     namespace {
         using Callback = void (*) (void*, int, char const*, char const*, sqlite3_int64);
-    }
+
+        /** The busy timeout of a connection without a contention policy in ms. */
+        const int DefaultBusyTimeout = 100;
+
+        const char* const JournalModes[] = {
+            "delete", "truncate", "persist", "memory", "wal", "off"};
+
+        const char* const NoSnapshots
+            = "The sqlite3 library has been built without snapshots";
+    } // namespace
 
     DbError::DbError (const std::string& what) : Error {what} {}
 
@@ -49,7 +59,14 @@ namespace cqlite {
      * @throws DbError on failure
      */
     Database::Database (const std::string& path, std::uint8_t mode) :
-        db_ {nullptr}, hooks_ {}
+        db_ {nullptr},
+        hooks_ {},
+        cache_ {},
+        contention_ {},
+        metrics_ {},
+        controls_ {},
+        savepoints_ {},
+        savepointDepth_ {0}
     {
         int flags
             = (mode & Mode::Create ? SQLITE_OPEN_CREATE : 0)
@@ -67,44 +84,93 @@ namespace cqlite {
             throw DbError {sqlite3_errstr (result)};
         }
 
-        // If assumed that "typeof (sqlite3_int64) is_interchangeable_to typeof
-        // (std::int64_t)", the following reinterpret_cast is safe.
-        sqlite3_update_hook (
-            db_, reinterpret_cast<Callback> (&Database::static_update_hook), this);
+        sqlite3_busy_timeout (db_, DefaultBusyTimeout);
+
+        // Arrays bound to statements are read with a table valued function.
+        result = detail::installArrays (db_);
+
+        if (result != SQLITE_OK) {
+            sqlite3_close (db_);
+            throw DbError {sqlite3_errstr (result)};
+        }
     }
 
-    Database::Database () : db_ {nullptr}, hooks_ {} {}
+    /**
+     * Opens a database connection on the given file and applies the given settings.
+     * Either all the settings are applied or the connection is closed again.
+     * @param path the path to the sqlite3 database file
+     * @param options the settings of the connection
+     * @param mode the mode to open the database in
+     * @throws DbError if the database cannot be opened or a setting cannot be applied
+     * @see DatabaseOptions
+     */
+    Database::Database (
+        const std::string& path, const DatabaseOptions& options, std::uint8_t mode) :
+        Database {path, mode}
+    {
+        configure (options);
+    }
 
-    Database::~Database () { sqlite3_close (db_); }
+    Database::Database () :
+        db_ {nullptr},
+        hooks_ {},
+        cache_ {},
+        contention_ {},
+        metrics_ {},
+        controls_ {},
+        savepoints_ {},
+        savepointDepth_ {0}
+    {}
+
+    Database::~Database ()
+    {
+        // The cached statements have to be finalized before the connection can be
+        // closed.
+        finalizeControls ();
+        cache_.reset ();
+        sqlite3_close (db_);
+    }
 
     Database::Database (Database&& other) :
-        db_ {other.db_}, hooks_ {std::move (other.hooks_)}
+        db_ {other.db_},
+        hooks_ {std::move (other.hooks_)},
+        cache_ {std::move (other.cache_)},
+        contention_ {std::move (other.contention_)},
+        metrics_ {std::move (other.metrics_)},
+        controls_ {std::move (other.controls_)},
+        savepoints_ {std::move (other.savepoints_)},
+        savepointDepth_ {other.savepointDepth_}
     {
         other.db_ = nullptr;
+        other.finalizeControls ();
 
-        if (db_) {
-            // rebind the hook - it still contains a pointer to the other database!
-            sqlite3_update_hook (
-                db_, reinterpret_cast<Callback> (&Database::static_update_hook), this);
-        }
+        // rebind the hooks - they still contain a pointer to the other database!
+        installHooks ();
     }
 
     Database& Database::operator= (Database&& other)
     {
         if (this != &other) {
 
+            finalizeControls ();
+            cache_.reset ();
             sqlite3_close (db_);
 
             db_ = other.db_;
             other.db_ = nullptr;
 
             hooks_ = std::move (other.hooks_);
+            cache_ = std::move (other.cache_);
+            contention_ = std::move (other.contention_);
+            metrics_ = std::move (other.metrics_);
+            controls_ = std::move (other.controls_);
+            savepoints_ = std::move (other.savepoints_);
+            savepointDepth_ = other.savepointDepth_;
 
-            if (db_) {
-                // rebind the hook - it still contains a pointer to the other database!
-                sqlite3_update_hook (db_,
-                    reinterpret_cast<Callback> (&Database::static_update_hook), this);
-            }
+            other.finalizeControls ();
+
+            // rebind the hooks - they still contain a pointer to the other database!
+            installHooks ();
         }
 
         return *this;
@@ -112,33 +178,71 @@ namespace cqlite {
 
     /**
      * Returns a prepared statement that is created from the given sql expression.
+     * If the statement cache is enabled, the statement is leased from the cache and
+     * handed back to it when it is destroyed.
      * @param sql the sql expression with optional placeholders (`?1`, `:name` etc.)
      * @return the corresponding statement
      * @throws DbError if the given statement cannot be compiled
+     * @see cacheStatements
      */
     Statement Database::prepare (const std::string& sql)
+    {
+        if (! cache_) {
+            Statement statement {compile (sql, 0)};
+            equip (statement, sql);
+
+            return statement;
+        }
+
+        if (sqlite3_stmt* stmt = cache_->checkout (sql)) {
+            Statement statement {stmt, cache_};
+            equip (statement, sql);
+
+            return statement;
+        }
+
+        Statement statement {compile (sql, SQLITE_PREPARE_PERSISTENT)};
+        equip (statement, sql);
+
+        if (cache_->insert (sql, statement.stmt_)) {
+            statement.cache_ = cache_;
+        }
+
+        return statement;
+    }
+
+    /**
+     * Compiles the given sql expression.
+     * @param sql the sql expression
+     * @param flags the SQLITE_PREPARE_* flags passed to sqlite3_prepare_v3
+     * @return the compiled statement, owned by the caller
+     * @throws DbError if the given statement cannot be compiled
+     */
+    sqlite3_stmt* Database::compile (const std::string& sql, unsigned int flags)
     {
         sqlite3_stmt* stmt;
-        std::size_t count {0};
         int result;
         const int Length = static_cast<int> (sql.size ());
         const char* const Content = sql.c_str ();
 
-        while ((result = sqlite3_prepare_v2 (db_, Content, Length, &stmt, nullptr))
-                   == SQLITE_BUSY
-               && ++count < 5) {
-            std::this_thread::sleep_for (std::chrono::milliseconds {20});
+        // Busy databases are waited for by the busy handler, locked tables of a
+        // shared cache by the contention policy.
+        while (Code::isLocked (result = sqlite3_prepare_v3 (
+                                   db_, Content, Length, flags, &stmt, nullptr))
+               && contention_ && contention_->locked (db_)) {
         }
 
         if (Code::isError (result)) {
             throw DbError {sqlite3_errstr (result)};
         }
 
-        return Statement {stmt};
+        return stmt;
     }
 
     /**
      * Executes the given statement directly on the database.
+     * The sql may consist of several statements, it is therefore not retried if a
+     * table of a shared cache is locked.
      * @param sql the sql to execute
      * @return this database
      * @throws DbError if the sql cannot be executed
@@ -146,14 +250,7 @@ namespace cqlite {
     Database& Database::operator<< (const std::string& sql)
     {
         char* errstr = nullptr;
-        std::size_t count {0};
-        int result;
-
-        while ((result = sqlite3_exec (db_, sql.c_str (), nullptr, nullptr, &errstr))
-                   == SQLITE_BUSY
-               && ++count < 5) {
-            std::this_thread::sleep_for (std::chrono::milliseconds {20});
-        }
+        int result = sqlite3_exec (db_, sql.c_str (), nullptr, nullptr, &errstr);
 
         if (Code::isError (result)) {
             std::string errmsg;
@@ -173,6 +270,373 @@ namespace cqlite {
         return *this;
     }
 
+    /**
+     * The effective settings of this connection.
+     * @return the settings as reported by sqlite, except for the lookaside memory
+     * @throws DbError if a setting cannot be queried
+     */
+    DatabaseOptions Database::options ()
+    {
+        using Options = DatabaseOptions;
+
+        Options options;
+        std::string journalMode;
+
+        prepare ("PRAGMA journal_mode").execute () >> journalMode;
+
+        for (std::size_t i = 0; i < std::size (JournalModes); ++i) {
+            if (journalMode == JournalModes[i]) {
+                options.journalMode = static_cast<Options::JournalMode> (i);
+            }
+        }
+
+        options.synchronous = static_cast<Options::Synchronous> (pragma ("synchronous"));
+        options.mmapSize = pragma ("mmap_size");
+        options.cacheSize = pragma ("cache_size");
+        options.pageSize = static_cast<std::size_t> (pragma ("page_size"));
+        options.tempStore = static_cast<Options::TempStore> (pragma ("temp_store"));
+        options.walAutocheckpoint
+            = static_cast<std::size_t> (pragma ("wal_autocheckpoint"));
+        options.foreignKeys = pragma ("foreign_keys") != 0;
+
+        return options;
+    }
+
+    void Database::configure (const DatabaseOptions& options)
+    {
+        // The lookaside memory can only be changed as long as none of it is in use.
+        if (options.lookaside) {
+            const int result = sqlite3_db_config (db_, SQLITE_DBCONFIG_LOOKASIDE, nullptr,
+                static_cast<int> (options.lookaside->slotSize),
+                static_cast<int> (options.lookaside->slots));
+
+            if (result != SQLITE_OK) {
+                throw DbError {sqlite3_errstr (result)};
+            }
+        }
+
+        // The page size has to be set before the journal mode, it cannot be changed
+        // in WAL mode.
+        if (options.pageSize) {
+            *this << "PRAGMA page_size = " + std::to_string (*options.pageSize);
+        }
+
+        if (options.journalMode) {
+            const std::string wanted
+                = JournalModes[static_cast<std::size_t> (*options.journalMode)];
+            std::string mode;
+
+            prepare ("PRAGMA journal_mode = " + wanted).execute () >> mode;
+
+            if (mode != wanted) {
+                throw DbError {"Unable to set the journal mode to " + wanted};
+            }
+        }
+
+        std::string pragmas;
+
+        if (options.synchronous) {
+            pragmas += "PRAGMA synchronous = "
+                + std::to_string (static_cast<int> (*options.synchronous)) + ";";
+        }
+
+        if (options.mmapSize) {
+            pragmas += "PRAGMA mmap_size = " + std::to_string (*options.mmapSize) + ";";
+        }
+
+        if (options.cacheSize) {
+            pragmas += "PRAGMA cache_size = " + std::to_string (*options.cacheSize) + ";";
+        }
+
+        if (options.tempStore) {
+            pragmas += "PRAGMA temp_store = "
+                + std::to_string (static_cast<int> (*options.tempStore)) + ";";
+        }
+
+        if (options.walAutocheckpoint) {
+            pragmas += "PRAGMA wal_autocheckpoint = "
+                + std::to_string (*options.walAutocheckpoint) + ";";
+        }
+
+        if (options.foreignKeys) {
+            pragmas += std::string {"PRAGMA foreign_keys = "}
+                + (*options.foreignKeys ? "ON" : "OFF") + ";";
+        }
+
+        if (! pragmas.empty ()) {
+            *this << pragmas;
+        }
+    }
+
+    std::int64_t Database::pragma (const std::string& name)
+    {
+        std::int64_t value = 0;
+        prepare ("PRAGMA " + name).execute () >> value;
+
+        return value;
+    }
+
+    /**
+     * Hands the contention policy and, if metrics are collected, a probe to a freshly
+     * prepared statement.
+     */
+    void Database::equip (Statement& statement, const std::string& sql) const
+    {
+        statement.contention_ = contention_;
+
+        if (metrics_) {
+            statement.probe_ = std::make_shared<StatementProbe> (
+                metrics_, MetricsRegistry::normalize (sql));
+        }
+    }
+
+    /**
+     * Starts or stops collecting the metrics of the statements prepared from now on.
+     * The metrics are aggregated by normalized sql text in a registry, which can be
+     * shared with a monitoring thread.
+     * @param enabled whether to collect metrics
+     * @return this database
+     * @see metrics, Statement::metrics
+     */
+    Database& Database::collectMetrics (bool enabled)
+    {
+        if (! enabled) {
+            metrics_.reset ();
+        }
+        else if (! metrics_) {
+            metrics_ = std::make_shared<MetricsRegistry> ();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Executes the given transaction control statement.
+     * The statement is compiled on first use and kept for the lifetime of the
+     * connection. Rolling back is skipped if sqlite already rolled back on its own.
+     * Ending the transaction ends all of its savepoints, guards that outlive it do not
+     * touch the savepoints of later transactions.
+     * @param which the statement to execute
+     * @throws DbError if the statement cannot be compiled
+     * @throws QueryError if the statement fails
+     */
+    void Database::control (Control which)
+    {
+        static const char* const Sql[NrOfControls] = {
+            "BEGIN DEFERRED",
+            "BEGIN IMMEDIATE",
+            "BEGIN EXCLUSIVE",
+            "COMMIT",
+            "ROLLBACK",
+        };
+
+        if (which == Rollback && sqlite3_get_autocommit (db_)) {
+            savepointDepth_ = 0;
+            return;
+        }
+
+        std::optional<Statement>& statement = controls_[which];
+
+        if (! statement) {
+            statement.emplace (compile (Sql[which], SQLITE_PREPARE_PERSISTENT));
+        }
+
+        statement->reset ().execute ();
+
+        if (which == Commit || which == Rollback) {
+            savepointDepth_ = 0;
+        }
+    }
+
+    /**
+     * Opens a new, nested savepoint.
+     * Savepoints are named after their depth, so their statements can be compiled once
+     * per depth and reused.
+     * @return the depth of the new savepoint, starting at 1, and its generation that
+     * tells it apart from earlier savepoints of the same depth
+     * @throws DbError if the statements cannot be compiled
+     * @throws QueryError if the savepoint cannot be opened
+     */
+    Database::SavepointMark Database::savepoint ()
+    {
+        // Without a transaction there are no savepoints left, whatever their guards say.
+        if (sqlite3_get_autocommit (db_)) {
+            savepointDepth_ = 0;
+        }
+
+        const std::size_t depth = savepointDepth_ + 1;
+
+        if (savepoints_.size () < depth) {
+            const std::string name = "cqlite_savepoint_" + std::to_string (depth);
+
+            savepoints_.push_back (SavepointControl {
+                Statement {compile ("SAVEPOINT " + name, SQLITE_PREPARE_PERSISTENT)},
+                Statement {compile ("RELEASE " + name, SQLITE_PREPARE_PERSISTENT)},
+                Statement {compile ("ROLLBACK TO " + name, SQLITE_PREPARE_PERSISTENT)},
+                0});
+        }
+
+        SavepointControl& control = savepoints_[depth - 1];
+
+        control.save.reset ().execute ();
+        savepointDepth_ = depth;
+
+        return SavepointMark {depth, ++control.generation};
+    }
+
+    /**
+     * Releases the given savepoint, together with all savepoints nested within it.
+     * Nothing is done if the savepoint already ended, because one it is nested within
+     * was released or rolled back.
+     * @param mark the savepoint
+     * @param rollback whether the changes since the savepoint are undone first
+     * @throws QueryError if the savepoint cannot be released or rolled back to
+     */
+    void Database::releaseSavepoint (const SavepointMark& mark, bool rollback)
+    {
+        if (! holds (mark)) {
+            return;
+        }
+
+        SavepointControl& control = savepoints_[mark.depth - 1];
+
+        // A rollback of the enclosing transaction already removed the savepoint.
+        if (! sqlite3_get_autocommit (db_)) {
+            if (rollback) {
+                control.rollback.reset ().execute ();
+            }
+
+            control.release.reset ().execute ();
+        }
+
+        savepointDepth_ = mark.depth - 1;
+    }
+
+    /**
+     * Finalizes the transaction control statements.
+     */
+    void Database::finalizeControls ()
+    {
+        for (std::optional<Statement>& statement : controls_) {
+            statement.reset ();
+        }
+
+        savepoints_.clear ();
+        savepointDepth_ = 0;
+    }
+
+    /**
+     * Sets the policy that decides how long to wait for locks held by other
+     * connections.
+     * Without a policy, a connection waits up to 100 ms for a busy database file and
+     * fails right away on tables locked in a shared cache. The policy only applies to
+     * statements prepared after it is set.
+     * @param policy the policy, it may be shared with other connections, null restores
+     * the default
+     * @return this database
+     * @see BusyTimeout, ExponentialBackoff, UnlockNotify
+     */
+    Database& Database::setContentionPolicy (std::shared_ptr<ContentionPolicy> policy)
+    {
+        contention_ = std::move (policy);
+
+        if (contention_) {
+            sqlite3_busy_handler (
+                db_, &ContentionPolicy::busyHandler, contention_.get ());
+        }
+        else {
+            sqlite3_busy_timeout (db_, DefaultBusyTimeout);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Enables the statement cache of this connection.
+     * Once enabled, prepare keeps up to the given number of compiled statements around
+     * and returns them again when the same sql is prepared later on, reset and with
+     * all bindings cleared. The least recently used statements are evicted first.
+     * Replacing or disabling the cache finalizes the statements that are not in use,
+     * the others are finalized when they are destroyed.
+     * @param capacity the maximal number of cached statements, 0 disables the cache
+     * @return this database
+     */
+    Database& Database::cacheStatements (std::size_t capacity)
+    {
+        cache_.reset ();
+
+        if (capacity > 0) {
+            cache_ = std::make_shared<StatementCache> (capacity);
+        }
+
+        return *this;
+    }
+
+    /**
+     * The usage of the statement cache.
+     * @return the hits, misses, size and capacity of the statement cache, all 0 if it
+     * is not enabled
+     */
+    StatementCache::Stats Database::statementCacheStats () const
+    {
+        return cache_ ? cache_->stats () : StatementCache::Stats {0, 0, 0, 0};
+    }
+
+    /**
+     * The memory usage of this connection.
+     * The lookaside slots are configured with DatabaseOptions::lookaside when the
+     * connection is opened, their counters stay 0 if sqlite is built with
+     * SQLITE_OMIT_LOOKASIDE.
+     * @param reset whether to reset the counters of the hits and misses and the
+     * high-water mark of the lookaside slots
+     * @return the usage of the lookaside slots and of the page caches
+     */
+    ConnectionMemoryStats Database::memoryStats (bool reset) const
+    {
+        // The current value and the high-water mark of a counter.
+        auto status = [this, reset] (int operation) {
+            int current = 0;
+            int highWater = 0;
+            sqlite3_db_status (db_, operation, &current, &highWater, reset ? 1 : 0);
+
+            return std::make_pair (static_cast<std::size_t> (current),
+                static_cast<std::size_t> (highWater));
+        };
+
+        ConnectionMemoryStats stats;
+
+        std::tie (stats.lookasideUsed, stats.lookasideHighWater)
+            = status (SQLITE_DBSTATUS_LOOKASIDE_USED);
+        // The hits and misses are only counted as high-water marks.
+        stats.lookasideHits = status (SQLITE_DBSTATUS_LOOKASIDE_HIT).second;
+        stats.lookasideMisses = status (SQLITE_DBSTATUS_LOOKASIDE_MISS_SIZE).second
+            + status (SQLITE_DBSTATUS_LOOKASIDE_MISS_FULL).second;
+        stats.cacheUsed = status (SQLITE_DBSTATUS_CACHE_USED).first;
+        stats.cacheHits = status (SQLITE_DBSTATUS_CACHE_HIT).first;
+        stats.cacheMisses = status (SQLITE_DBSTATUS_CACHE_MISS).first;
+
+        return stats;
+    }
+
+    /**
+     * Sets the hook that gets all the rows changed by a transaction as one batch when
+     * the transaction is committed, the rows of a rolled back transaction are dropped.
+     * The batch hook is called from within the commit and must not use this
+     * connection, an UpdateQueue can hand the batches over to another thread.
+     * Note that rows changed within a savepoint that is rolled back are still part of
+     * the batch.
+     * @param hook the batch hook, an empty hook switches the buffering off
+     * @return this database
+     * @see UpdateQueue
+     */
+    Database& Database::setUpdateBatchHook (UpdateBatchHook hook)
+    {
+        hooks_.buffer (std::move (hook));
+        installHooks ();
+
+        return *this;
+    }
+
     /**
      * The static update hook function used with the sqlite3 C-API
      * @param me a pointer to a database
@@ -185,40 +649,212 @@ namespace cqlite {
         void* me, int operation, char const* db, char const* table, std::int64_t rowid)
     {
         Database* self = static_cast<Database*> (me);
+        Operation op = Operation::Delete;
+
+        switch (operation) {
+            case SQLITE_INSERT:
+                op = Operation::Insert;
+                break;
+            case SQLITE_DELETE:
+                op = Operation::Delete;
+                break;
+            case SQLITE_UPDATE:
+                op = Operation::Update;
+                break;
+            default:
+                return;
+        }
 
-        auto range = self->hooks_.equal_range (table);
-        auto atHook = range.first;
-        const auto endOfHooks = range.second;
-
-        auto catchall = self->hooks_.equal_range ("*");
-        auto atCatchall = catchall.first;
-        auto endOfCatchall = catchall.second;
-
-        if (atHook != endOfHooks || atCatchall != endOfCatchall) {
-            Operation op = Operation::Delete;
-
-            switch (operation) {
-                case SQLITE_INSERT:
-                    op = Operation::Insert;
-                    break;
-                case SQLITE_DELETE:
-                    op = Operation::Delete;
-                    break;
-                case SQLITE_UPDATE:
-                    op = Operation::Update;
-                    break;
-                default:
-                    return;
-            }
+        self->hooks_.dispatch (op, db, table, rowid);
+    }
 
-            for (; atHook != endOfHooks; ++atHook) {
-                atHook->second (op, db, table, rowid);
-            }
+    /**
+     * The commit hook function used with the sqlite3 C-API, delivers the batch.
+     * @param me a pointer to a database
+     * @return 0 in order to let the commit proceed
+     */
+    int Database::static_commit_hook (void* me)
+    {
+        static_cast<Database*> (me)->hooks_.commit ();
+        return 0;
+    }
 
-            for (; atCatchall != endOfCatchall; ++atCatchall) {
-                atCatchall->second (op, db, table, rowid);
-            }
+    /**
+     * The rollback hook function used with the sqlite3 C-API, drops the batch.
+     * @param me a pointer to a database
+     */
+    void Database::static_rollback_hook (void* me)
+    {
+        static_cast<Database*> (me)->hooks_.rollback ();
+    }
+
+    /**
+     * Registers the hook functions with this connection as long as they have anything
+     * to do, so that connections without hooks do not pay for them.
+     */
+    void Database::installHooks ()
+    {
+        if (! db_) {
+            return;
+        }
+
+        // If assumed that "typeof (sqlite3_int64) is_interchangeable_to typeof
+        // (std::int64_t)", the following reinterpret_cast is safe.
+        sqlite3_update_hook (db_,
+            hooks_.active () ? reinterpret_cast<Callback> (&Database::static_update_hook)
+                             : nullptr,
+            this);
+
+        if (hooks_.buffered ()) {
+            sqlite3_commit_hook (db_, &Database::static_commit_hook, this);
+            sqlite3_rollback_hook (db_, &Database::static_rollback_hook, this);
+        }
+        else {
+            sqlite3_commit_hook (db_, nullptr, nullptr);
+            sqlite3_rollback_hook (db_, nullptr, nullptr);
+        }
+    }
+
+    /**
+     * Registers the given sql function with this connection.
+     * Its data is owned by sqlite, which destroys it when the function is replaced, the
+     * connection is closed or the registration fails.
+     * @param name the name of the function
+     * @param definition the callbacks and data of the function
+     * @param deterministic whether the function is deterministic
+     * @throws DbError if the function cannot be registered
+     */
+    void Database::define (const std::string& name,
+        const detail::FunctionDefinition& definition, bool deterministic)
+    {
+        const int flags = SQLITE_UTF8 | (deterministic ? SQLITE_DETERMINISTIC : 0);
+
+        int result = sqlite3_create_function_v2 (db_, name.c_str (), definition.arguments,
+            flags, definition.data, definition.call, definition.step, definition.final,
+            definition.destroy);
+
+        if (result != SQLITE_OK) {
+            throw DbError {sqlite3_errmsg (db_)};
+        }
+    }
+
+    /**
+     * Registers the given virtual table module with this connection, replacing a module
+     * of the same name.
+     * Its data is owned by sqlite, which destroys it when the module is replaced, the
+     * connection is closed or the registration fails.
+     * @param name the name of the module, which is also the name of its table
+     * @param definition the module and its data
+     * @throws DbError if the module cannot be registered
+     */
+    void Database::define (
+        const std::string& name, const detail::ModuleDefinition& definition)
+    {
+        int result = sqlite3_create_module_v2 (
+            db_, name.c_str (), definition.module, definition.data, definition.destroy);
+
+        if (result != SQLITE_OK) {
+            throw DbError {sqlite3_errmsg (db_)};
+        }
+    }
+
+    /**
+     * Takes a snapshot of the current state of the given schema, which must be in WAL
+     * mode.
+     * Within a transaction the snapshot is the state this transaction reads, otherwise
+     * a read transaction is begun and ended for it.
+     * A snapshot needs at least one transaction written to the WAL since it was
+     * created, the WAL of a database that was just opened, or that has been
+     * checkpointed and restarted, does not have any snapshots yet.
+     * @param schema the name of the schema, "main" or the name of an attached database
+     * @return the snapshot
+     * @throws SnapshotError if no snapshot can be taken, e.g. if the schema is not in
+     * WAL mode, nothing has been written to its WAL yet or sqlite has been built
+     * without snapshots
+     * @throws QueryError if the read transaction cannot be begun or ended
+     */
+    Snapshot Database::snapshot (const std::string& schema)
+    {
+#ifdef CQLITE_HAVE_SNAPSHOT
+        const bool owned = sqlite3_get_autocommit (db_) != 0;
+
+        if (owned) {
+            control (BeginDeferred);
+        }
+
+        // Reading anything of the schema opens its read transaction.
+        std::string read {"SELECT 1 FROM \""};
+
+        for (char c : schema) {
+            read += c == '"' ? std::string {"\"\""} : std::string {c};
+        }
+
+        read += "\".sqlite_master LIMIT 1";
+        sqlite3_snapshot* taken = nullptr;
+
+        int result = sqlite3_exec (db_, read.c_str (), nullptr, nullptr, nullptr);
+
+        if (result == SQLITE_OK) {
+            result = sqlite3_snapshot_get (db_, schema.c_str (), &taken);
+        }
+
+        Snapshot snapshot {taken};
+        std::string errmsg {result != SQLITE_OK ? sqlite3_errmsg (db_) : ""};
+
+        if (owned) {
+            control (result == SQLITE_OK ? Commit : Rollback);
         }
+
+        if (result != SQLITE_OK) {
+            throw SnapshotError {errmsg};
+        }
+
+        return snapshot;
+#else
+        static_cast<void> (schema);
+
+        throw SnapshotError {NoSnapshots};
+#endif
+    }
+
+    /**
+     * Lets the current transaction read the given snapshot instead of the latest state,
+     * e.g. in order to run the queries of a report on many connections that all see
+     * the same data:
+     * @code
+
+     cqlite::Transaction read {reader};
+     reader.openSnapshot (snapshot);
+     ...
+     read.commit ();
+
+     @endcode
+     * The transaction must not have read from the schema yet, and the snapshot must
+     * still be available, i.e. the WAL file has not been restarted by a checkpoint
+     * since it has been taken.
+     * @param snapshot a snapshot taken of the same database file
+     * @param schema the name of the schema, "main" or the name of an attached database
+     * @throws SnapshotError if there is no transaction, the snapshot is not available
+     * anymore or sqlite has been built without snapshots
+     */
+    void Database::openSnapshot (const Snapshot& snapshot, const std::string& schema)
+    {
+#ifdef CQLITE_HAVE_SNAPSHOT
+        if (sqlite3_get_autocommit (db_)) {
+            throw SnapshotError {"A snapshot can only be opened within a transaction"};
+        }
+
+        int result = sqlite3_snapshot_open (db_, schema.c_str (), snapshot.snapshot_);
+
+        if (result != SQLITE_OK) {
+            throw SnapshotError {sqlite3_errmsg (db_)};
+        }
+#else
+        static_cast<void> (snapshot);
+        static_cast<void> (schema);
+
+        throw SnapshotError {NoSnapshots};
+#endif
     }
 
     /**
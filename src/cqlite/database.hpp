@@ -25,18 +25,34 @@
 #ifndef CQLITE_DATABASE_INC
 #define CQLITE_DATABASE_INC
 
+#include <cqlite/cache.hpp>
+#include <cqlite/contention.hpp>
 #include <cqlite/cqlite_config.hpp>
 #include <cqlite/cqlite_export.hpp>
 #include <cqlite/error.hpp>
+#include <cqlite/functions.hpp>
+#include <cqlite/hooks.hpp>
+#include <cqlite/memory.hpp>
+#include <cqlite/metrics.hpp>
+#include <cqlite/options.hpp>
+#include <cqlite/snapshot.hpp>
 #include <cqlite/statement.hpp>
+#include <cqlite/table.hpp>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace cqlite {
 
@@ -55,12 +71,7 @@ namespace cqlite {
     class CQLITE_EXPORT Database
     {
       public:
-        enum class Operation
-        {
-            Insert,
-            Delete,
-            Update
-        };
+        using Operation = UpdateOperation;
 
         /**
          * The mode to open the database with.
@@ -90,20 +101,15 @@ namespace cqlite {
             FullMutex = 1 << 7,
         };
 
-        /**
-         * The callback that is triggered on every modifying database operation.
-         * @param op Insert, Delete, or Update
-         * @param db the name of the affected database (probably just "main")
-         * @param table the name of the affected table
-         * @param rowid the rowid of the affected row
-         */
-        using UpdateHook = std::function<void (Operation op, const std::string& db,
-            const std::string& table, std::int64_t rowid)>;
+        /** @see cqlite::UpdateHook */
+        using UpdateHook = cqlite::UpdateHook;
 
       public:
         Database ();
         explicit Database (const std::string&,
             std::uint8_t = Mode::ReadWrite | Mode::Create | Mode::NoMutex);
+        Database (const std::string&, const DatabaseOptions&,
+            std::uint8_t = Mode::ReadWrite | Mode::Create | Mode::NoMutex);
         ~Database ();
 
         Database (const Database&) = delete;
@@ -114,25 +120,146 @@ namespace cqlite {
         Statement prepare (const std::string&);
         Database& operator<< (const std::string&);
 
+        DatabaseOptions options ();
+
+        Database& cacheStatements (std::size_t);
+        StatementCache::Stats statementCacheStats () const;
+
+        ConnectionMemoryStats memoryStats (bool = false) const;
+
+        Database& collectMetrics (bool);
+        const std::shared_ptr<MetricsRegistry>& metrics () const;
+
+        Database& setContentionPolicy (std::shared_ptr<ContentionPolicy>);
+        const std::shared_ptr<ContentionPolicy>& contentionPolicy () const;
+
         template <typename Hook>
         Database& addUpdateHook (const std::string& table, Hook&& hook);
+        Database& setUpdateBatchHook (UpdateBatchHook);
+
+        template <typename Function>
+        Database& createFunction (const std::string&, Function&&, bool = false);
+
+        template <typename State, typename Step, typename Final>
+        Database& createAggregate (const std::string&, Step&&, Final&&, bool = false);
+
+        template <typename Range, typename... Columns>
+        Database& createVirtualTable (const std::string&, const Range&, Columns...);
+        template <typename Range, typename... Columns>
+        Database& createVirtualTable (
+            const std::string&, const Range&&, Columns...) = delete;
+
+        Snapshot snapshot (const std::string& = "main");
+        void openSnapshot (const Snapshot&, const std::string& = "main");
 
         std::int64_t lastInsertId () const;
 
+      private:
+        friend class Backup;
+        friend class BlobBuffer;
+        friend class Savepoint;
+        friend class Session;
+        friend class Transaction;
+
+        /** The transaction control statements, prepared once per connection. */
+        enum Control
+        {
+            BeginDeferred,
+            BeginImmediate,
+            BeginExclusive,
+            Commit,
+            Rollback,
+            NrOfControls
+        };
+
+        struct SavepointControl
+        {
+            Statement save;
+            Statement release;
+            Statement rollback;
+            std::uint64_t generation;
+        };
+
+        /** Identifies an opened savepoint, its depth is reused once it is released. */
+        struct SavepointMark
+        {
+            std::size_t depth;
+            std::uint64_t generation;
+        };
+
       private:
         static void static_update_hook (
             void*, int, char const*, char const*, std::int64_t);
+        static int static_commit_hook (void*);
+        static void static_rollback_hook (void*);
+
+        void installHooks ();
+
+        void define (const std::string&, const detail::FunctionDefinition&, bool);
+        void define (const std::string&, const detail::ModuleDefinition&);
+
+        sqlite3_stmt* compile (const std::string&, unsigned int);
+        void equip (Statement&, const std::string&) const;
+
+        void configure (const DatabaseOptions&);
+        std::int64_t pragma (const std::string&);
+
+        void control (Control);
+        SavepointMark savepoint ();
+        void releaseSavepoint (const SavepointMark&, bool);
+        bool holds (const SavepointMark&) const;
+        void finalizeControls ();
 
       private:
         sqlite3* db_;
-        std::multimap<std::string, UpdateHook> hooks_;
+        UpdateHooks hooks_;
+        std::shared_ptr<StatementCache> cache_;
+        std::shared_ptr<ContentionPolicy> contention_;
+        std::shared_ptr<MetricsRegistry> metrics_;
+
+        std::array<std::optional<Statement>, NrOfControls> controls_;
+        std::vector<SavepointControl> savepoints_;
+        std::size_t savepointDepth_;
     };
 
+    /**
+     * Whether the given savepoint is still open, i.e. neither it nor a savepoint or
+     * transaction it is nested within has ended.
+     * @param mark the savepoint
+     * @return true iff the savepoint is open
+     */
+    inline bool Database::holds (const SavepointMark& mark) const
+    {
+        return mark.depth != 0 && mark.depth <= savepointDepth_
+            && savepoints_[mark.depth - 1].generation == mark.generation;
+    }
+
+    /**
+     * The policy that decides how long to wait for locks held by other connections.
+     * @return the policy, null if the connection uses the default busy timeout
+     */
+    inline const std::shared_ptr<ContentionPolicy>& Database::contentionPolicy () const
+    {
+        return contention_;
+    }
+
+    /**
+     * The registry the statements of this connection record their metrics into.
+     * @return the registry, null if no metrics are collected
+     */
+    inline const std::shared_ptr<MetricsRegistry>& Database::metrics () const
+    {
+        return metrics_;
+    }
+
     /*!
      * @brief Adds an update hook callback that gets called on every
      *        update/insert/delete on the given table.
      *
-     * If "*" is given for \a table the hook is executed on every table.
+     * If "*" is given for \a table the hook is executed on every table. The hooks are
+     * looked up by a hash of the table name, so that no memory is allocated for an
+     * event. Hooks that take the names as std::string instead of std::string_view are
+     * still supported, at the cost of copying the names for every call.
      *
      * @tparam Hook Any callable that can be converted to an @ref UpdateHook
      * @see UpdateHook
@@ -143,7 +270,142 @@ namespace cqlite {
     template <typename Hook>
     inline Database& Database::addUpdateHook (const std::string& table, Hook&& hook)
     {
-        hooks_.insert ({table, std::forward<Hook> (hook)});
+        if constexpr (std::is_invocable_v<Hook&, Operation, std::string_view,
+                          std::string_view, std::int64_t>) {
+            hooks_.add (table, UpdateHook {std::forward<Hook> (hook)});
+        }
+        else {
+            hooks_.add (table,
+                [hook = std::forward<Hook> (hook)] (Operation op, std::string_view db,
+                    std::string_view name, std::int64_t rowid) mutable {
+                    hook (op, std::string {db}, std::string {name}, rowid);
+                });
+        }
+
+        installHooks ();
+
+        return *this;
+    }
+
+    /**
+     * Registers a scalar sql function that calls the given function, e.g.
+     * @code
+
+     db.createFunction ("score", [] (std::string_view name, double weight) {
+         return name.size () * weight;
+     }, true);
+
+     db.prepare ("SELECT score (name, weight) FROM things");
+
+     @endcode
+     * The number and the types of the arguments are deduced from the function, it may
+     * take numbers, std::string, std::optional (null for sql NULL), std::string_view
+     * and BlobView. The views refer to the values of sqlite without copying them, so
+     * they are valid for the call only. The result is converted the same way, a void
+     * function returns NULL. Exceptions thrown by the function fail the statement
+     * with their message.
+     * @param name the name of the sql function
+     * @param function a callable with a fixed signature (no generic lambda)
+     * @param deterministic whether the function always returns the same result for the
+     * same arguments, which lets sqlite use it in indexes and factor it out of loops
+     * @return this database
+     * @throws DbError if the function cannot be registered
+     */
+    template <typename Function>
+    inline Database& Database::createFunction (
+        const std::string& name, Function&& function, bool deterministic)
+    {
+        define (name, detail::scalar (std::forward<Function> (function)), deterministic);
+
+        return *this;
+    }
+
+    /**
+     * Registers an aggregate sql function, e.g.
+     * @code
+
+     struct Mean
+     {
+         double sum = 0;
+         std::size_t count = 0;
+     };
+
+     db.createAggregate<Mean> ("mean",
+         [] (Mean& mean, double value) { mean.sum += value; ++mean.count; },
+         [] (const Mean& mean) -> std::optional<double> {
+             if (mean.count == 0) {
+                 return std::nullopt;
+             }
+
+             return mean.sum / mean.count;
+         });
+
+     @endcode
+     * Every group gets its own default constructed state. The step function takes the
+     * state followed by the arguments, which are decoded as with createFunction, and
+     * the final function turns the state into the result of the group.
+     * @tparam State the state of a group
+     * @param name the name of the sql function
+     * @param step the callable called for every row of a group
+     * @param final the callable called at the end of a group, also for empty groups
+     * @param deterministic whether the function always returns the same result for the
+     * same rows
+     * @return this database
+     * @throws DbError if the function cannot be registered
+     */
+    template <typename State, typename Step, typename Final>
+    inline Database& Database::createAggregate (
+        const std::string& name, Step&& step, Final&& final, bool deterministic)
+    {
+        define (name,
+            detail::aggregate<State> (
+                std::forward<Step> (step), std::forward<Final> (final)),
+            deterministic);
+
+        return *this;
+    }
+
+    /**
+     * Exposes the given rows as a read-only virtual table, without copying them, e.g.
+     * @code
+
+     struct Country
+     {
+         std::string code;
+         std::string name;
+         double population;
+     };
+
+     std::vector<Country> countries = ...;
+
+     db.createVirtualTable ("countries", countries,
+         cqlite::key ("code", &Country::code),
+         cqlite::column ("name", &Country::name),
+         cqlite::column ("density", [] (const Country& country) { return ...; }));
+
+     db.prepare ("SELECT c.name FROM cities JOIN countries c ON c.code = country");
+
+     @endcode
+     * The rowid of a row is its position within the range, lookups by rowid and by the
+     * key column (if any) do not scan the range. The range is referred to, it must
+     * outlive the table and it must not change while it is exposed, the table is to be
+     * created again after a change.
+     * @param name the name of the table
+     * @param rows a random access range, e.g. a std::vector
+     * @param columns the columns, created with column or key
+     * @return this database
+     * @throws DbError if the table cannot be created
+     */
+    template <typename Range, typename... Columns>
+    inline Database& Database::createVirtualTable (
+        const std::string& name, const Range& rows, Columns... columns)
+    {
+        static_assert (sizeof...(Columns) > 0, "A virtual table needs a column");
+
+        define (name,
+            detail::ContainerTable<Range, Columns...>::define (
+                rows, std::move (columns)...));
+
         return *this;
     }
 } // namespace cqlite
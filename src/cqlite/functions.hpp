@@ -0,0 +1,420 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * functions.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_FUNCTIONS_INC
+#define CQLITE_FUNCTIONS_INC
+
+#include <cqlite/datetime.hpp>
+#include <cqlite/rows.hpp>
+#include <cqlite/view.hpp>
+
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cqlite {
+
+    namespace detail {
+
+        /**
+         * The callbacks and the user data of an sql function, as they are registered
+         * with sqlite3_create_function_v2.
+         */
+        struct FunctionDefinition
+        {
+            int arguments;
+            void* data;
+            void (*call) (sqlite3_context*, int, sqlite3_value**);
+            void (*step) (sqlite3_context*, int, sqlite3_value**);
+            void (*final) (sqlite3_context*);
+            void (*destroy) (void*);
+        };
+
+        template <typename Function>
+        struct FunctionTraits : FunctionTraits<decltype (&Function::operator())>
+        {};
+
+        template <typename Return, typename... Arguments>
+        struct FunctionTraits<Return (*) (Arguments...)>
+        {
+            using Result = Return;
+            using Parameters = std::tuple<std::decay_t<Arguments>...>;
+        };
+
+        template <typename Return, typename... Arguments>
+        struct FunctionTraits<Return (Arguments...)> :
+            FunctionTraits<Return (*) (Arguments...)>
+        {};
+
+        template <typename Return, typename Class, typename... Arguments>
+        struct FunctionTraits<Return (Class::*) (Arguments...)> :
+            FunctionTraits<Return (*) (Arguments...)>
+        {};
+
+        template <typename Return, typename Class, typename... Arguments>
+        struct FunctionTraits<Return (Class::*) (Arguments...) const> :
+            FunctionTraits<Return (*) (Arguments...)>
+        {};
+
+        template <typename Tuple>
+        struct Tail;
+
+        template <typename Head, typename... Rest>
+        struct Tail<std::tuple<Head, Rest...>>
+        {
+            using type = std::tuple<Rest...>;
+        };
+
+        template <typename T>
+        inline void readArgument (sqlite3_value*, T&)
+        {
+            static_assert (AlwaysFalse<T>, "There is no argument reader for this type");
+        }
+
+        inline void readArgument (sqlite3_value* value, int& argument)
+        {
+            argument = sqlite3_value_int (value);
+        }
+
+        inline void readArgument (sqlite3_value* value, bool& argument)
+        {
+            argument = sqlite3_value_int (value) != 0;
+        }
+
+        inline void readArgument (sqlite3_value* value, std::int64_t& argument)
+        {
+            argument = sqlite3_value_int64 (value);
+        }
+
+        inline void readArgument (sqlite3_value* value, std::size_t& argument)
+        {
+            argument = static_cast<std::size_t> (sqlite3_value_int64 (value));
+        }
+
+        inline void readArgument (sqlite3_value* value, double& argument)
+        {
+            argument = sqlite3_value_double (value);
+        }
+
+        inline void readArgument (sqlite3_value* value, DateTime& argument)
+        {
+            argument = DateTime {DateTime::duration {sqlite3_value_int64 (value)}};
+        }
+
+        /** Views the text of the argument, which is valid for the call only. */
+        inline void readArgument (sqlite3_value* value, std::string_view& argument)
+        {
+            const unsigned char* const text = sqlite3_value_text (value);
+
+            argument = text ? std::string_view {reinterpret_cast<const char*> (text),
+                                  static_cast<std::size_t> (sqlite3_value_bytes (value))}
+                            : std::string_view {};
+        }
+
+        inline void readArgument (sqlite3_value* value, std::string& argument)
+        {
+            std::string_view text;
+            readArgument (value, text);
+            argument.assign (text.data (), text.size ());
+        }
+
+        /** Views the blob of the argument, which is valid for the call only. */
+        inline void readArgument (sqlite3_value* value, BlobView& argument)
+        {
+            const void* const data = sqlite3_value_blob (value);
+
+            argument = BlobView {
+                data, static_cast<std::size_t> (sqlite3_value_bytes (value))};
+        }
+
+        template <typename T>
+        inline void readArgument (sqlite3_value* value, std::optional<T>& argument)
+        {
+            if (sqlite3_value_type (value) == SQLITE_NULL) {
+                argument.reset ();
+            }
+            else {
+                readArgument (value, argument.emplace ());
+            }
+        }
+
+        template <typename T>
+        inline void setResult (sqlite3_context*, const T&)
+        {
+            static_assert (AlwaysFalse<T>, "There is no result writer for this type");
+        }
+
+        inline void setResult (sqlite3_context* context, int value)
+        {
+            sqlite3_result_int (context, value);
+        }
+
+        inline void setResult (sqlite3_context* context, bool value)
+        {
+            sqlite3_result_int (context, value ? 1 : 0);
+        }
+
+        inline void setResult (sqlite3_context* context, std::int64_t value)
+        {
+            sqlite3_result_int64 (context, value);
+        }
+
+        inline void setResult (sqlite3_context* context, std::size_t value)
+        {
+            sqlite3_result_int64 (context, static_cast<std::int64_t> (value));
+        }
+
+        inline void setResult (sqlite3_context* context, double value)
+        {
+            sqlite3_result_double (context, value);
+        }
+
+        inline void setResult (sqlite3_context* context, std::nullptr_t)
+        {
+            sqlite3_result_null (context);
+        }
+
+        inline void setResult (sqlite3_context* context, const DateTime& value)
+        {
+            sqlite3_result_int64 (context, value.time_since_epoch ().count ());
+        }
+
+        /** The text is copied, since it may view an argument. */
+        inline void setResult (sqlite3_context* context, std::string_view value)
+        {
+            sqlite3_result_text64 (context, value.data () ? value.data () : "",
+                value.size (), SQLITE_TRANSIENT, SQLITE_UTF8);
+        }
+
+        inline void setResult (sqlite3_context* context, const std::string& value)
+        {
+            setResult (context, std::string_view {value});
+        }
+
+        inline void setResult (sqlite3_context* context, const char* value)
+        {
+            if (value) {
+                setResult (context, std::string_view {value});
+            }
+            else {
+                sqlite3_result_null (context);
+            }
+        }
+
+        /** The blob is copied, since it may view an argument. */
+        inline void setResult (sqlite3_context* context, BlobView value)
+        {
+            sqlite3_result_blob64 (context, value.data () ? value.data () : "",
+                value.size (), SQLITE_TRANSIENT);
+        }
+
+        template <typename T>
+        inline void setResult (sqlite3_context* context, const std::optional<T>& value)
+        {
+            if (value) {
+                setResult (context, *value);
+            }
+            else {
+                sqlite3_result_null (context);
+            }
+        }
+
+        /**
+         * Calls the given function with the decoded arguments, preceded by the given
+         * leading arguments.
+         */
+        template <typename Parameters, typename Function, std::size_t... Index,
+            typename... Leading>
+        inline decltype (auto) invoke (Function& function, sqlite3_value** values,
+            std::index_sequence<Index...>, Leading&... leading)
+        {
+            [[maybe_unused]] Parameters arguments;
+            (readArgument (values[Index], std::get<Index> (arguments)), ...);
+
+            return function (leading..., std::move (std::get<Index> (arguments))...);
+        }
+
+        /**
+         * Reports the exceptions of a user function as the error of the sql function,
+         * they must not pass through sqlite.
+         */
+        template <typename Body>
+        inline void guard (sqlite3_context* context, Body&& body)
+        {
+            try {
+                body ();
+            }
+            catch (const std::bad_alloc&) {
+                sqlite3_result_error_nomem (context);
+            }
+            catch (const std::exception& e) {
+                sqlite3_result_error (context, e.what (), -1);
+            }
+            catch (...) {
+                sqlite3_result_error (context, "Unknown error in a user function", -1);
+            }
+        }
+
+        template <typename Result, typename Call>
+        inline void result (sqlite3_context* context, Call&& call)
+        {
+            if constexpr (std::is_void_v<Result>) {
+                call ();
+                sqlite3_result_null (context);
+            }
+            else {
+                setResult (context, call ());
+            }
+        }
+
+        template <typename Function>
+        inline void callScalar (sqlite3_context* context, int, sqlite3_value** values)
+        {
+            using Result = typename FunctionTraits<Function>::Result;
+            using Parameters = typename FunctionTraits<Function>::Parameters;
+            Function& function = *static_cast<Function*> (sqlite3_user_data (context));
+
+            guard (context, [&] {
+                result<Result> (context, [&] () -> decltype (auto) {
+                    return invoke<Parameters> (function, values,
+                        std::make_index_sequence<std::tuple_size_v<Parameters>> {});
+                });
+            });
+        }
+
+        template <typename T>
+        inline void destroy (void* data)
+        {
+            delete static_cast<T*> (data);
+        }
+
+        /**
+         * The definition of a scalar function.
+         * The function is moved to the heap and owned by sqlite from now on.
+         */
+        template <typename Function>
+        inline FunctionDefinition scalar (Function&& function)
+        {
+            using Type = std::decay_t<Function>;
+            using Parameters = typename FunctionTraits<Type>::Parameters;
+
+            static_assert (std::tuple_size_v<Parameters> <= 127,
+                "An sql function takes at most 127 arguments");
+
+            return FunctionDefinition {static_cast<int> (std::tuple_size_v<Parameters>),
+                new Type {std::forward<Function> (function)}, &callScalar<Type>, nullptr,
+                nullptr, &destroy<Type>};
+        }
+
+        template <typename State, typename Step, typename Final>
+        struct Aggregate
+        {
+            Step step;
+            Final final;
+        };
+
+        template <typename State, typename Step, typename Final>
+        inline void stepAggregate (sqlite3_context* context, int, sqlite3_value** values)
+        {
+            using Parameters =
+                typename Tail<typename FunctionTraits<Step>::Parameters>::type;
+            auto& aggregate = *static_cast<Aggregate<State, Step, Final>*> (
+                sqlite3_user_data (context));
+
+            // The context is zeroed when it is allocated by the first step of a group.
+            auto** state = static_cast<State**> (
+                sqlite3_aggregate_context (context, sizeof (State*)));
+
+            if (! state) {
+                sqlite3_result_error_nomem (context);
+                return;
+            }
+
+            guard (context, [&] {
+                if (! *state) {
+                    *state = new State {};
+                }
+
+                invoke<Parameters> (aggregate.step, values,
+                    std::make_index_sequence<std::tuple_size_v<Parameters>> {}, **state);
+            });
+        }
+
+        template <typename State, typename Step, typename Final>
+        inline void finalAggregate (sqlite3_context* context)
+        {
+            auto& aggregate = *static_cast<Aggregate<State, Step, Final>*> (
+                sqlite3_user_data (context));
+            auto** slot = static_cast<State**> (sqlite3_aggregate_context (context, 0));
+
+            // Without rows there is no state yet, the final value of a fresh one is used.
+            std::unique_ptr<State> state {slot ? *slot : nullptr};
+
+            guard (context, [&] {
+                if (! state) {
+                    state = std::make_unique<State> ();
+                }
+
+                result<std::invoke_result_t<Final&, State&>> (context,
+                    [&] () -> decltype (auto) { return aggregate.final (*state); });
+            });
+        }
+
+        /**
+         * The definition of an aggregate function.
+         * The functions are moved to the heap and owned by sqlite from now on.
+         */
+        template <typename State, typename Step, typename Final>
+        inline FunctionDefinition aggregate (Step&& step, Final&& final)
+        {
+            using StepType = std::decay_t<Step>;
+            using FinalType = std::decay_t<Final>;
+            using Type = Aggregate<State, StepType, FinalType>;
+            using Parameters =
+                typename Tail<typename FunctionTraits<StepType>::Parameters>::type;
+
+            static_assert (std::is_default_constructible_v<State>,
+                "The state of an aggregate must be default constructible");
+            static_assert (std::tuple_size_v<Parameters> <= 127,
+                "An sql function takes at most 127 arguments");
+
+            return FunctionDefinition {static_cast<int> (std::tuple_size_v<Parameters>),
+                new Type {std::forward<Step> (step), std::forward<Final> (final)},
+                nullptr, &stepAggregate<State, StepType, FinalType>,
+                &finalAggregate<State, StepType, FinalType>, &destroy<Type>};
+        }
+    } // namespace detail
+} // namespace cqlite
+
+#endif /* CQLITE_FUNCTIONS_INC */
@@ -0,0 +1,200 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * hooks.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/hooks.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace cqlite {
+
+    UpdateHooks::UpdateHooks () :
+        byTable_ {},
+        everyTable_ {},
+        batchHook_ {},
+        pending_ {},
+        names_ {}
+    {}
+
+    /**
+     * Adds a hook for the given table.
+     * @param table the name of the table, "*" for every table
+     * @param hook the hook
+     */
+    void UpdateHooks::add (const std::string& table, UpdateHook hook)
+    {
+        if (table == "*") {
+            everyTable_.push_back (std::move (hook));
+        }
+        else {
+            byTable_[std::hash<std::string_view> {}(table)].push_back (
+                Entry {table, std::move (hook)});
+        }
+    }
+
+    /**
+     * Sets the hook that gets the events of every committed transaction as one batch.
+     * @param hook the batch hook, an empty hook switches the buffering off
+     */
+    void UpdateHooks::buffer (UpdateBatchHook hook)
+    {
+        batchHook_ = std::move (hook);
+        pending_.clear ();
+    }
+
+    /**
+     * Calls the hooks of the given table and of every table with the given event and
+     * collects it for the batch hook.
+     */
+    void UpdateHooks::dispatch (UpdateOperation operation, std::string_view db,
+        std::string_view table, std::int64_t rowid)
+    {
+        if (! byTable_.empty ()) {
+            auto at = byTable_.find (std::hash<std::string_view> {}(table));
+
+            if (at != byTable_.end ()) {
+                for (const Entry& entry : at->second) {
+                    if (entry.table == table) {
+                        entry.hook (operation, db, table, rowid);
+                    }
+                }
+            }
+        }
+
+        for (const UpdateHook& hook : everyTable_) {
+            hook (operation, db, table, rowid);
+        }
+
+        if (batchHook_) {
+            pending_.push_back (
+                UpdateEvent {operation, intern (db), intern (table), rowid});
+        }
+    }
+
+    /**
+     * Delivers the collected events to the batch hook.
+     */
+    void UpdateHooks::commit ()
+    {
+        if (batchHook_ && ! pending_.empty ()) {
+            batchHook_ (pending_);
+        }
+
+        pending_.clear ();
+    }
+
+    /**
+     * Drops the collected events.
+     */
+    void UpdateHooks::rollback () { pending_.clear (); }
+
+    /**
+     * The permanent copy of the given name, which is created the first time a name
+     * is seen.
+     */
+    std::string_view UpdateHooks::intern (std::string_view name)
+    {
+        std::forward_list<std::string>& names
+            = names_[std::hash<std::string_view> {}(name)];
+
+        auto at = std::find (names.begin (), names.end (), name);
+
+        if (at == names.end ()) {
+            names.emplace_front (name);
+            return names.front ();
+        }
+
+        return *at;
+    }
+
+    /**
+     * Creates an empty queue.
+     * @param capacity the maximal number of batches waiting for the consumer
+     */
+    UpdateQueue::UpdateQueue (std::size_t capacity) :
+        slots_ (std::max<std::size_t> (capacity, 1)),
+        head_ {0},
+        tail_ {0},
+        dropped_ {0}
+    {}
+
+    /**
+     * Appends a copy of the given batch, may only be called by the producer.
+     * @param batch the events of one transaction
+     * @return true iff the batch has been queued, false if the queue is full
+     */
+    bool UpdateQueue::push (const std::vector<UpdateEvent>& batch)
+    {
+        const std::size_t tail = tail_.load (std::memory_order_relaxed);
+
+        if (tail - head_.load (std::memory_order_acquire) == slots_.size ()) {
+            dropped_.fetch_add (1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // The slot keeps its capacity, so copying does not allocate in the long run.
+        slots_[tail % slots_.size ()].assign (batch.begin (), batch.end ());
+        tail_.store (tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Takes the oldest batch, may only be called by the consumer.
+     * @param batch receives the events, its memory is reused by the queue
+     * @return true iff there was a batch
+     */
+    bool UpdateQueue::pop (std::vector<UpdateEvent>& batch)
+    {
+        const std::size_t head = head_.load (std::memory_order_relaxed);
+
+        if (head == tail_.load (std::memory_order_acquire)) {
+            return false;
+        }
+
+        batch.swap (slots_[head % slots_.size ()]);
+        head_.store (head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * A batch hook that pushes to this queue, which has to outlive the connection.
+     * @return the batch hook
+     * @see Database::setUpdateBatchHook
+     */
+    UpdateBatchHook UpdateQueue::hook ()
+    {
+        return [this] (const std::vector<UpdateEvent>& events) { push (events); };
+    }
+
+    /**
+     * The number of batches that have been dropped since the queue was full.
+     * @return the number of dropped batches
+     */
+    std::size_t UpdateQueue::dropped () const
+    {
+        return dropped_.load (std::memory_order_relaxed);
+    }
+} // namespace cqlite
@@ -0,0 +1,176 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * hooks.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_HOOKS_INC
+#define CQLITE_HOOKS_INC
+
+#include <cqlite/cqlite_export.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cqlite {
+
+    enum class UpdateOperation
+    {
+        Insert,
+        Delete,
+        Update
+    };
+
+    /**
+     * One changed row.
+     * The names refer to storage of the connection and stay valid as long as the
+     * connection exists.
+     */
+    struct UpdateEvent
+    {
+        UpdateOperation operation;
+        std::string_view database;
+        std::string_view table;
+        std::int64_t rowid;
+    };
+
+    /**
+     * The callback that is triggered on every modifying database operation.
+     * @param op Insert, Delete, or Update
+     * @param db the name of the affected database (probably just "main")
+     * @param table the name of the affected table
+     * @param rowid the rowid of the affected row
+     */
+    using UpdateHook = std::function<void (UpdateOperation op, std::string_view db,
+        std::string_view table, std::int64_t rowid)>;
+
+    /**
+     * The callback that is triggered with all the rows changed by a transaction when
+     * it is committed.
+     * @param events the changed rows in the order of their change
+     */
+    using UpdateBatchHook = std::function<void (const std::vector<UpdateEvent>& events)>;
+
+    /**
+     * The update hooks of one connection, hashed by table name.
+     *
+     * Dispatching an event neither allocates nor copies the names. If a batch hook is
+     * set, the events are additionally collected until the transaction ends.
+     */
+    class CQLITE_EXPORT UpdateHooks
+    {
+      public:
+        UpdateHooks ();
+
+        void add (const std::string&, UpdateHook);
+        void buffer (UpdateBatchHook);
+
+        bool active () const;
+        bool buffered () const;
+
+        void dispatch (UpdateOperation, std::string_view, std::string_view, std::int64_t);
+        void commit ();
+        void rollback ();
+
+      private:
+        struct Entry
+        {
+            std::string table;
+            UpdateHook hook;
+        };
+
+        std::string_view intern (std::string_view);
+
+      private:
+        std::unordered_map<std::size_t, std::vector<Entry>> byTable_;
+        std::vector<UpdateHook> everyTable_;
+
+        UpdateBatchHook batchHook_;
+        std::vector<UpdateEvent> pending_;
+
+        /** The names referred to by the pending events, by their hash */
+        std::unordered_map<std::size_t, std::forward_list<std::string>> names_;
+    };
+
+    /**
+     * A bounded single producer, single consumer queue of update batches, which hands
+     * the batches of one connection over to a consumer thread without locking, e.g.
+     * @code
+
+     cqlite::UpdateQueue queue {64};
+     db.setUpdateBatchHook (queue.hook ());
+     ...
+     // on the consumer thread
+     std::vector<cqlite::UpdateEvent> batch;
+
+     while (queue.pop (batch)) {
+         ...
+     }
+
+     @endcode
+     * Batches that do not fit into a full queue are dropped and counted.
+     */
+    class CQLITE_EXPORT UpdateQueue
+    {
+      public:
+        explicit UpdateQueue (std::size_t);
+
+        UpdateQueue (const UpdateQueue&) = delete;
+        UpdateQueue& operator= (const UpdateQueue&) = delete;
+
+        bool push (const std::vector<UpdateEvent>&);
+        bool pop (std::vector<UpdateEvent>&);
+
+        UpdateBatchHook hook ();
+
+        std::size_t dropped () const;
+
+      private:
+        std::vector<std::vector<UpdateEvent>> slots_;
+        std::atomic<std::size_t> head_;
+        std::atomic<std::size_t> tail_;
+        std::atomic<std::size_t> dropped_;
+    };
+
+    /**
+     * Whether there is any hook to be called.
+     * @return true iff a hook or a batch hook is set
+     */
+    inline bool UpdateHooks::active () const
+    {
+        return ! byTable_.empty () || ! everyTable_.empty () || buffered ();
+    }
+
+    /**
+     * Whether the events are collected for a batch hook.
+     * @return true iff a batch hook is set
+     */
+    inline bool UpdateHooks::buffered () const { return static_cast<bool> (batchHook_); }
+} // namespace cqlite
+
+#endif /* CQLITE_HOOKS_INC */
@@ -0,0 +1,118 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * memory.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/memory.hpp>
+
+#include <sqlite3.h>
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace cqlite {
+
+    namespace {
+        /** Page cache slots are aligned to 8 bytes. */
+        const std::size_t SlotAlignment = 8;
+
+        std::mutex arenaMutex;
+        std::unique_ptr<unsigned char[]> arena;
+
+        void status (int operation, std::int64_t& current, std::int64_t& highWater,
+            bool reset)
+        {
+            sqlite3_int64 now = 0;
+            sqlite3_int64 high = 0;
+            sqlite3_status64 (operation, &now, &high, reset ? 1 : 0);
+
+            current = now;
+            highWater = high;
+        }
+    } // namespace
+
+    MemoryError::MemoryError (const std::string& what) : Error {what} {}
+
+    MemoryError::MemoryError (const char* what) : Error {what} {}
+
+    /**
+     * Preallocates one arena of page cache memory for all connections of this process,
+     * pages that do not fit into it are allocated one by one as usual.
+     * Sqlite only accepts this configuration before it is initialized, i.e. before the
+     * first connection is opened, or after sqlite3_shutdown.
+     * @param pageSize the largest page size of the databases in bytes
+     * @param pages the number of pages of the arena, 0 removes the arena
+     * @throws MemoryError if sqlite is already initialized
+     */
+    void configurePageCache (std::size_t pageSize, std::size_t pages)
+    {
+        std::lock_guard<std::mutex> lock {arenaMutex};
+
+        int header = 0;
+        sqlite3_config (SQLITE_CONFIG_PCACHE_HDRSZ, &header);
+
+        const std::size_t slot = (pageSize + static_cast<std::size_t> (header)
+                                     + SlotAlignment - 1)
+            / SlotAlignment * SlotAlignment;
+
+        std::unique_ptr<unsigned char[]> memory;
+
+        if (pages > 0) {
+            memory.reset (new unsigned char[slot * pages]);
+        }
+
+        const int result = sqlite3_config (SQLITE_CONFIG_PAGECACHE, memory.get (),
+            static_cast<int> (slot), static_cast<int> (pages));
+
+        if (result != SQLITE_OK) {
+            throw MemoryError {
+                "The page cache can only be configured before sqlite is initialized"};
+        }
+
+        // Sqlite is not initialized, so nothing uses the previous arena anymore.
+        arena = std::move (memory);
+    }
+
+    /**
+     * The memory usage of sqlite within this process.
+     * The statistics are all 0 if sqlite is built or configured without
+     * SQLITE_CONFIG_MEMSTATUS.
+     * @param reset whether to reset the high-water marks to the current values
+     * @return the allocated memory, the page cache arena usage and their high-water
+     * marks
+     */
+    MemoryStats memoryStats (bool reset)
+    {
+        MemoryStats stats {};
+        std::int64_t unused = 0;
+
+        status (SQLITE_STATUS_MEMORY_USED, stats.memoryUsed, stats.memoryHighWater,
+            reset);
+        status (SQLITE_STATUS_MALLOC_SIZE, unused, stats.mallocHighWater, reset);
+        status (SQLITE_STATUS_PAGECACHE_USED, stats.pageCacheUsed, unused, reset);
+        status (SQLITE_STATUS_PAGECACHE_OVERFLOW, stats.pageCacheOverflow, unused,
+            reset);
+
+        return stats;
+    }
+} // namespace cqlite
@@ -0,0 +1,91 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * memory.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_MEMORY_INC
+#define CQLITE_MEMORY_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cqlite {
+
+    class CQLITE_EXPORT MemoryError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit MemoryError (const std::string&);
+        explicit MemoryError (const char*);
+    };
+
+    /**
+     * The memory usage of one connection.
+     * @see Database::memoryStats
+     */
+    struct ConnectionMemoryStats
+    {
+        /** The number of lookaside slots in use */
+        std::size_t lookasideUsed;
+        /** The highest number of lookaside slots in use at the same time */
+        std::size_t lookasideHighWater;
+        /** The number of allocations served from the lookaside slots */
+        std::size_t lookasideHits;
+        /** The number of small allocations that missed the lookaside slots, because
+         * they were too large or all slots were in use */
+        std::size_t lookasideMisses;
+        /** The number of bytes used by the page caches */
+        std::size_t cacheUsed;
+        /** The number of pages found in the page caches */
+        std::size_t cacheHits;
+        /** The number of pages that had to be read into the page caches */
+        std::size_t cacheMisses;
+    };
+
+    /**
+     * The memory usage of sqlite within this process, over all connections.
+     * @see memoryStats
+     */
+    struct MemoryStats
+    {
+        /** The number of bytes allocated by sqlite */
+        std::int64_t memoryUsed;
+        /** The highest number of bytes allocated at the same time */
+        std::int64_t memoryHighWater;
+        /** The size of the largest allocation in bytes */
+        std::int64_t mallocHighWater;
+        /** The number of pages of the page cache arena in use */
+        std::int64_t pageCacheUsed;
+        /** The number of bytes of page cache that did not fit into the arena */
+        std::int64_t pageCacheOverflow;
+    };
+
+    CQLITE_EXPORT void configurePageCache (std::size_t, std::size_t);
+    CQLITE_EXPORT MemoryStats memoryStats (bool = false);
+} // namespace cqlite
+
+#endif /* CQLITE_MEMORY_INC */
@@ -0,0 +1,213 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * metrics.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/metrics.hpp>
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace cqlite {
+
+    namespace {
+
+        std::uint64_t status (sqlite3_stmt* stmt, int counter, bool reset)
+        {
+            return static_cast<std::uint64_t> (
+                sqlite3_stmt_status (stmt, counter, reset ? 1 : 0));
+        }
+
+        bool isSpace (char c) { return std::isspace (static_cast<unsigned char> (c)); }
+
+        bool isWord (char c)
+        {
+            return std::isalnum (static_cast<unsigned char> (c)) || c == '_' || c == '$';
+        }
+    } // namespace
+
+    /**
+     * Adds the given metrics, the memory used is the maximum of both.
+     * @param other the metrics to add
+     * @return these metrics
+     */
+    StatementMetrics& StatementMetrics::operator+= (const StatementMetrics& other)
+    {
+        executions += other.executions;
+        steps += other.steps;
+        fullScanSteps += other.fullScanSteps;
+        sorts += other.sorts;
+        autoIndexes += other.autoIndexes;
+        vmSteps += other.vmSteps;
+        reprepares += other.reprepares;
+        memoryUsed = std::max (memoryUsed, other.memoryUsed);
+        elapsed += other.elapsed;
+
+        return *this;
+    }
+
+    MetricsRegistry::MetricsRegistry () : mutex_ {}, entries_ {} {}
+
+    /**
+     * Adds the given metrics to those of the given sql.
+     * @param sql the normalized sql text
+     * @param metrics the metrics of executions not yet recorded
+     */
+    void MetricsRegistry::record (const std::string& sql, const StatementMetrics& metrics)
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        entries_[sql] += metrics;
+    }
+
+    /**
+     * A copy of the current metrics.
+     * @return the metrics by normalized sql text
+     */
+    MetricsRegistry::Snapshot MetricsRegistry::snapshot () const
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        return entries_;
+    }
+
+    /**
+     * Forgets all metrics.
+     */
+    void MetricsRegistry::reset ()
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        entries_.clear ();
+    }
+
+    /**
+     * The key of the given sql within a registry: whitespace is collapsed and string
+     * and numeric literals are replaced by `?`, so that statements differing only in
+     * their literals share their metrics.
+     * @param sql the sql text
+     * @return the normalized sql text
+     */
+    std::string MetricsRegistry::normalize (std::string_view sql)
+    {
+        std::string normalized;
+        normalized.reserve (sql.size ());
+
+        for (std::size_t i = 0; i < sql.size ();) {
+            const char c = sql[i];
+
+            if (isSpace (c)) {
+                while (i < sql.size () && isSpace (sql[i])) {
+                    ++i;
+                }
+
+                if (! normalized.empty () && i < sql.size ()) {
+                    normalized += ' ';
+                }
+            }
+            else if (c == '\'') {
+                // A quote within a literal is written twice.
+                for (++i; i < sql.size (); ++i) {
+                    if (sql[i] == '\'') {
+                        if (i + 1 < sql.size () && sql[i + 1] == '\'') {
+                            ++i;
+                        }
+                        else {
+                            ++i;
+                            break;
+                        }
+                    }
+                }
+
+                normalized += '?';
+            }
+            else if (std::isdigit (static_cast<unsigned char> (c))
+                     && (normalized.empty () || ! isWord (normalized.back ()))) {
+                while (i < sql.size () && (isWord (sql[i]) || sql[i] == '.')) {
+                    ++i;
+                }
+
+                normalized += '?';
+            }
+            else {
+                normalized += c;
+                ++i;
+            }
+        }
+
+        return normalized;
+    }
+
+    /**
+     * Creates a probe that records into the given registry.
+     * @param registry the registry
+     * @param sql the normalized sql text of the statement
+     */
+    StatementProbe::StatementProbe (
+        std::shared_ptr<MetricsRegistry> registry, std::string sql) :
+        registry_ {std::move (registry)},
+        sql_ {std::move (sql)},
+        pending_ {},
+        totals_ {}
+    {}
+
+    /**
+     * Counts one execution.
+     */
+    void StatementProbe::executed () { ++pending_.executions; }
+
+    /**
+     * Counts one step.
+     * @param elapsed the time the step took
+     */
+    void StatementProbe::stepped (Clock::duration elapsed)
+    {
+        using std::chrono::nanoseconds;
+
+        ++pending_.steps;
+        pending_.elapsed += std::chrono::duration_cast<nanoseconds> (elapsed);
+    }
+
+    /**
+     * Adds the counters of the statement since the last flush and the measured
+     * executions to the totals and to the registry, if it has been stepped since.
+     * @param stmt the statement, whose counters are reset
+     */
+    void StatementProbe::flush (sqlite3_stmt* stmt)
+    {
+        if (pending_.steps == 0) {
+            return;
+        }
+
+        pending_.fullScanSteps = status (stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, true);
+        pending_.sorts = status (stmt, SQLITE_STMTSTATUS_SORT, true);
+        pending_.autoIndexes = status (stmt, SQLITE_STMTSTATUS_AUTOINDEX, true);
+        pending_.vmSteps = status (stmt, SQLITE_STMTSTATUS_VM_STEP, true);
+        pending_.reprepares = status (stmt, SQLITE_STMTSTATUS_REPREPARE, true);
+        pending_.memoryUsed = status (stmt, SQLITE_STMTSTATUS_MEMUSED, false);
+
+        totals_ += pending_;
+        registry_->record (sql_, pending_);
+
+        pending_ = StatementMetrics {};
+    }
+} // namespace cqlite
@@ -0,0 +1,132 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * metrics.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_METRICS_INC
+#define CQLITE_METRICS_INC
+
+#include <cqlite/cqlite_export.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+struct sqlite3_stmt;
+
+namespace cqlite {
+
+    /**
+     * What the executions of a statement cost.
+     */
+    struct CQLITE_EXPORT StatementMetrics
+    {
+        /** The number of executions */
+        std::uint64_t executions;
+        /** The number of calls of sqlite3_step */
+        std::uint64_t steps;
+        /** The number of steps through a table or index without an index lookup */
+        std::uint64_t fullScanSteps;
+        /** The number of sort operations */
+        std::uint64_t sorts;
+        /** The number of rows inserted into automatic indexes */
+        std::uint64_t autoIndexes;
+        /** The number of virtual machine operations */
+        std::uint64_t vmSteps;
+        /** The number of automatic recompilations after schema changes */
+        std::uint64_t reprepares;
+        /** The memory used by the prepared statement in bytes, the maximum if
+         * aggregated */
+        std::uint64_t memoryUsed;
+        /** The wall clock time spent in sqlite3_step */
+        std::chrono::nanoseconds elapsed;
+
+        StatementMetrics& operator+= (const StatementMetrics&);
+    };
+
+    /**
+     * The metrics of the statements of one connection, aggregated by their normalized
+     * sql text.
+     *
+     * The statements record into the registry on the thread of their connection, while
+     * a monitoring thread may take snapshots or reset it at any time.
+     * @see Database::collectMetrics
+     */
+    class CQLITE_EXPORT MetricsRegistry
+    {
+      public:
+        using Snapshot = std::map<std::string, StatementMetrics>;
+
+      public:
+        MetricsRegistry ();
+
+        MetricsRegistry (const MetricsRegistry&) = delete;
+        MetricsRegistry& operator= (const MetricsRegistry&) = delete;
+
+        void record (const std::string&, const StatementMetrics&);
+
+        Snapshot snapshot () const;
+        void reset ();
+
+        static std::string normalize (std::string_view);
+
+      private:
+        mutable std::mutex mutex_;
+        Snapshot entries_;
+    };
+
+    /**
+     * Measures the executions of one statement for a registry.
+     */
+    class CQLITE_EXPORT StatementProbe
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+      public:
+        StatementProbe (std::shared_ptr<MetricsRegistry>, std::string);
+
+        void executed ();
+        void stepped (Clock::duration);
+        void flush (sqlite3_stmt*);
+
+        const StatementMetrics& totals () const;
+
+      private:
+        std::shared_ptr<MetricsRegistry> registry_;
+        std::string sql_;
+        StatementMetrics pending_;
+        StatementMetrics totals_;
+    };
+
+    /**
+     * The metrics of all the flushed executions.
+     * @return the accumulated metrics
+     */
+    inline const StatementMetrics& StatementProbe::totals () const { return totals_; }
+} // namespace cqlite
+
+#endif /* CQLITE_METRICS_INC */
@@ -0,0 +1,85 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * options.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/options.hpp>
+
+namespace cqlite {
+
+    /**
+     * Settings for many concurrent readers and few writers: WAL, so that readers and
+     * the writer do not block each other, a large memory mapped region and cache, and
+     * temporary tables in memory.
+     * @return the settings
+     */
+    DatabaseOptions DatabaseOptions::readHeavy ()
+    {
+        DatabaseOptions options;
+
+        options.journalMode = JournalMode::Wal;
+        options.synchronous = Synchronous::Normal;
+        options.mmapSize = 256 * 1024 * 1024;
+        options.cacheSize = -64 * 1024;
+        options.tempStore = TempStore::Memory;
+
+        return options;
+    }
+
+    /**
+     * Settings for loading large amounts of data as fast as possible: the journal is
+     * kept in memory and nothing is synced, so a crash in the middle of a load may
+     * corrupt the database. Foreign keys are not checked.
+     * @return the settings
+     */
+    DatabaseOptions DatabaseOptions::bulkLoad ()
+    {
+        DatabaseOptions options;
+
+        options.journalMode = JournalMode::Memory;
+        options.synchronous = Synchronous::Off;
+        options.cacheSize = -256 * 1024;
+        options.tempStore = TempStore::Memory;
+        options.foreignKeys = false;
+
+        return options;
+    }
+
+    /**
+     * Settings for transactional workloads that must not lose a committed
+     * transaction: WAL synced on every commit, regular checkpoints and enforced
+     * foreign keys.
+     * @return the settings
+     */
+    DatabaseOptions DatabaseOptions::durableOltp ()
+    {
+        DatabaseOptions options;
+
+        options.journalMode = JournalMode::Wal;
+        options.synchronous = Synchronous::Full;
+        options.cacheSize = -16 * 1024;
+        options.walAutocheckpoint = 1000;
+        options.foreignKeys = true;
+
+        return options;
+    }
+} // namespace cqlite
@@ -0,0 +1,99 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * options.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_OPTIONS_INC
+#define CQLITE_OPTIONS_INC
+
+#include <cqlite/cqlite_export.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace cqlite {
+
+    /**
+     * The storage settings of a connection, which are applied when it is opened.
+     *
+     * Settings that are not set keep the defaults of sqlite (or of the database file).
+     * @see Database::Database, Database::options
+     */
+    struct CQLITE_EXPORT DatabaseOptions
+    {
+        enum class JournalMode
+        {
+            Delete,
+            Truncate,
+            Persist,
+            Memory,
+            Wal,
+            Off
+        };
+
+        enum class Synchronous
+        {
+            Off,
+            Normal,
+            Full,
+            Extra
+        };
+
+        enum class TempStore
+        {
+            Default,
+            File,
+            Memory
+        };
+
+        /** The per connection memory for small allocations. */
+        struct Lookaside
+        {
+            /** The size of one slot in bytes */
+            std::size_t slotSize;
+            /** The number of slots */
+            std::size_t slots;
+        };
+
+        std::optional<JournalMode> journalMode;
+        std::optional<Synchronous> synchronous;
+        /** The maximal number of bytes accessed through memory mapping, 0 disables it */
+        std::optional<std::int64_t> mmapSize;
+        /** The page cache size, a number of pages if positive or of KiB if negative */
+        std::optional<std::int64_t> cacheSize;
+        /** The page size of a new database in bytes, a power of two */
+        std::optional<std::size_t> pageSize;
+        std::optional<TempStore> tempStore;
+        /** The number of WAL pages after which a checkpoint is run, 0 disables it */
+        std::optional<std::size_t> walAutocheckpoint;
+        /** Cannot be read back and is left unset by Database::options */
+        std::optional<Lookaside> lookaside;
+        std::optional<bool> foreignKeys;
+
+        static DatabaseOptions readHeavy ();
+        static DatabaseOptions bulkLoad ();
+        static DatabaseOptions durableOltp ();
+    };
+} // namespace cqlite
+
+#endif /* CQLITE_OPTIONS_INC */
@@ -0,0 +1,136 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * parallel.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/parallel.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace cqlite {
+
+    ParallelScanError::ParallelScanError (const std::string& what) : Error {what} {}
+
+    ParallelScanError::ParallelScanError (const char* what) : Error {what} {}
+
+    /**
+     * Prepares a scan of the given database file.
+     * @param path the path to the sqlite3 database file
+     * @param shards the maximal number of shards and therefore of threads and
+     * connections, 0 for as many as the hardware runs concurrently
+     */
+    ParallelScan::ParallelScan (std::string path, std::size_t shards) :
+        path_ {std::move (path)},
+        shards_ {shards != 0
+                ? shards
+                : std::max<std::size_t> (std::thread::hardware_concurrency (), 1)},
+        keys_ {}
+    {}
+
+    /**
+     * Sets the keys to scan.
+     * @param first the first key
+     * @param last the last key, the key space is empty if it is less than the first
+     * @return this scan
+     */
+    ParallelScan& ParallelScan::keys (std::int64_t first, std::int64_t last)
+    {
+        keys_ = Range {first, last};
+        return *this;
+    }
+
+    /**
+     * Sets the keys to scan from the result of a query, e.g.
+     * "SELECT MIN (id), MAX (id) FROM authors".
+     * @param sql the query that returns the first and the last key as a single row, the
+     * key space is empty if they are null
+     * @return this scan
+     * @throws StatementError if the query does not have two columns
+     * @throws DbError if the query cannot be compiled
+     * @throws QueryError if the query fails
+     */
+    ParallelScan& ParallelScan::keys (const std::string& sql)
+    {
+        Database db = open ();
+        Statement statement = db.prepare (sql);
+
+        keys_ = Range {1, 0};
+
+        using Key = std::optional<std::int64_t>;
+
+        for (auto [first, last] : statement.rows<Key, Key> ()) {
+            if (first && last) {
+                keys_ = Range {*first, *last};
+            }
+            break;
+        }
+
+        return *this;
+    }
+
+    /**
+     * The ranges of keys the shards scan, which split the key space into parts of
+     * equal size. There are fewer ranges than shards if there are fewer keys.
+     * @return the ranges in the order of their keys
+     * @throws ParallelScanError if no keys have been given
+     */
+    std::vector<ParallelScan::Range> ParallelScan::ranges () const
+    {
+        if (! keys_) {
+            throw ParallelScanError {"The keys of a parallel scan have not been given"};
+        }
+
+        std::vector<Range> ranges;
+
+        if (keys_->last < keys_->first) {
+            return ranges;
+        }
+
+        // Unsigned arithmetic, the key space may span more than the signed maximum.
+        const std::uint64_t span = static_cast<std::uint64_t> (keys_->last)
+            - static_cast<std::uint64_t> (keys_->first);
+        const std::uint64_t step = span / shards_;
+
+        std::uint64_t first = static_cast<std::uint64_t> (keys_->first);
+        std::uint64_t left = span;
+
+        while (true) {
+            const std::uint64_t last = first + std::min (step, left);
+            ranges.push_back (Range {
+                static_cast<std::int64_t> (first), static_cast<std::int64_t> (last)});
+
+            if (left <= step) {
+                return ranges;
+            }
+
+            first = last + 1;
+            left -= step + 1;
+        }
+    }
+
+    Database ParallelScan::open () const
+    {
+        return Database {path_, Database::ReadOnly | Database::NoMutex};
+    }
+} // namespace cqlite
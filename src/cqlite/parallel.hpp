@@ -0,0 +1,246 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * parallel.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_PARALLEL_INC
+#define CQLITE_PARALLEL_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/error.hpp>
+#include <cqlite/snapshot.hpp>
+#include <cqlite/statement.hpp>
+#include <cqlite/transaction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cqlite {
+
+    class CQLITE_EXPORT ParallelScanError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit ParallelScanError (const std::string&);
+        explicit ParallelScanError (const char*);
+    };
+
+    /**
+     * Runs one query over a range of integer keys, e.g. the rowids of a table, split
+     * into a number of shards that are scanned concurrently.
+     *
+     * Every shard gets a read-only connection and a thread of its own, the query binds
+     * the first and the last key of the shard as its parameters ?1 and ?2:
+     * @code
+     ParallelScan scan {"authors.db", 4};
+     scan.keys ("SELECT MIN (id), MAX (id) FROM authors");
+
+     double total = scan.reduce<double> (
+         "SELECT weight FROM authors WHERE id BETWEEN ?1 AND ?2", 0.0,
+         [] (double& sum, double weight) { sum += weight; },
+         [] (double& sum, double shard) { sum += shard; });
+     * @endcode
+     *
+     * Each shard reads within a transaction of its own, so the shards only see the same
+     * state of the database if it is not written to meanwhile, or if a Snapshot is
+     * given that all of them open. In-memory databases cannot be shared between
+     * connections and are therefore not supported.
+     */
+    class CQLITE_EXPORT ParallelScan
+    {
+      public:
+        /** A range of keys, both bounds included. */
+        struct Range
+        {
+            std::int64_t first;
+            std::int64_t last;
+        };
+
+      public:
+        explicit ParallelScan (std::string, std::size_t = 0);
+
+        ParallelScan& keys (std::int64_t, std::int64_t);
+        ParallelScan& keys (const std::string&);
+
+        std::vector<Range> ranges () const;
+        std::size_t shards () const;
+
+        template <typename... Columns, typename Partial, typename Fold, typename Merge>
+        Partial reduce (
+            const std::string&, Partial, Fold, Merge, const Snapshot* = nullptr) const;
+
+        template <typename... Columns>
+        std::vector<std::tuple<Columns...>> collect (
+            const std::string&, const Snapshot* = nullptr) const;
+
+      private:
+        Database open () const;
+
+        template <typename... Columns, typename Partial, typename Fold>
+        Partial scan (const std::string&, Range, Partial, Fold, const Snapshot*) const;
+
+      private:
+        std::string path_;
+        std::size_t shards_;
+        std::optional<Range> keys_;
+    };
+
+    /**
+     * Scans the shards concurrently and combines what they found.
+     * Every shard folds its rows into a partial result of its own that starts as a
+     * copy of the initial one, the partial results are then merged on the calling
+     * thread in the order of the shards.
+     * @param sql the query, which selects the rows of the keys from ?1 to ?2
+     * @param init the partial result every shard starts with, usually the neutral
+     * element of the merge, it is returned as is if there are no keys
+     * @param fold the callable that adds a row to a partial result, it is called as
+     * fold (Partial&, const Columns&...) and it is copied for every shard
+     * @param merge the callable that adds the partial result of the next shard to the
+     * first one, called as merge (Partial&, Partial&&)
+     * @param snapshot the state of the database all shards read, null for the latest
+     * state when each shard begins, it must outlive this call
+     * @return the merged result
+     * @throws ParallelScanError if no keys have been given
+     * @throws SnapshotError if the snapshot cannot be opened
+     * @throws StatementError if the query does not have two parameters or the given
+     * number of columns
+     * @throws DbError if the query cannot be compiled
+     * @throws QueryError if the query fails, the first error of the shards in their
+     * order is thrown after all of them have finished
+     */
+    template <typename... Columns, typename Partial, typename Fold, typename Merge>
+    inline Partial ParallelScan::reduce (
+        const std::string& sql, Partial init, Fold fold, Merge merge,
+        const Snapshot* snapshot) const
+    {
+        std::vector<Range> shards = ranges ();
+
+        if (shards.empty ()) {
+            return init;
+        }
+
+        std::vector<std::future<Partial>> partials;
+        partials.reserve (shards.size ());
+
+        // The futures of std::async wait for their threads when they are destroyed, so
+        // no shard outlives this call, not even if another one throws.
+        for (const Range& range : shards) {
+            partials.push_back (std::async (
+                std::launch::async, [this, &sql, range, init, fold, snapshot] {
+                    return scan<Columns...> (sql, range, init, fold, snapshot);
+                }));
+        }
+
+        Partial result = partials.front ().get ();
+
+        for (auto at = std::next (partials.begin ()); at != partials.end (); ++at) {
+            merge (result, at->get ());
+        }
+
+        return result;
+    }
+
+    /**
+     * Scans the shards concurrently and collects all their rows.
+     * @param sql the query, which selects the rows of the keys from ?1 to ?2
+     * @param snapshot the state of the database all shards read, see reduce
+     * @return the rows, shard after shard, in the order the query returns them within
+     * a shard
+     * @throws ParallelScanError if no keys have been given
+     * @throws SnapshotError if the snapshot cannot be opened
+     * @throws StatementError if the query does not have two parameters or the given
+     * number of columns
+     * @throws DbError if the query cannot be compiled
+     * @throws QueryError if the query fails
+     */
+    template <typename... Columns>
+    inline std::vector<std::tuple<Columns...>> ParallelScan::collect (
+        const std::string& sql, const Snapshot* snapshot) const
+    {
+        static_assert (detail::AreOwning<Columns...>,
+            "Views do not survive the step to the next row");
+
+        using Row = std::tuple<Columns...>;
+
+        return reduce<Columns...> (sql, std::vector<Row> {},
+            [] (std::vector<Row>& rows, const Columns&... columns) {
+                rows.emplace_back (columns...);
+            },
+            [] (std::vector<Row>& rows, std::vector<Row>&& shard) {
+                rows.insert (rows.end (), std::make_move_iterator (shard.begin ()),
+                    std::make_move_iterator (shard.end ()));
+            },
+            snapshot);
+    }
+
+    template <typename... Columns, typename Partial, typename Fold>
+    inline Partial ParallelScan::scan (
+        const std::string& sql, Range range, Partial partial, Fold fold,
+        const Snapshot* snapshot) const
+    {
+        Database db = open ();
+        Transaction read {db};
+
+        // The snapshot has to be opened before anything is read, even the schema.
+        if (snapshot) {
+            db.openSnapshot (*snapshot);
+        }
+
+        {
+            Statement statement = db.prepare (sql);
+
+            if (statement.parameters () != 2) {
+                throw StatementError {"A parallel scan binds exactly two parameters, "
+                                      "the first and last key"};
+            }
+
+            statement.bind (1, range.first);
+            statement.bind (2, range.last);
+
+            for (const auto& row : statement.rows<Columns...> ()) {
+                std::apply (
+                    [&] (const auto&... columns) { fold (partial, columns...); }, row);
+            }
+        }
+
+        read.commit ();
+
+        return partial;
+    }
+
+    /**
+     * The number of shards the keys are split into at most.
+     * @return the number of shards
+     */
+    inline std::size_t ParallelScan::shards () const { return shards_; }
+} // namespace cqlite
+
+#endif /* CQLITE_PARALLEL_INC */
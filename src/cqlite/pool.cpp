@@ -0,0 +1,306 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * pool.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/pool.hpp>
+
+#include <cctype>
+#include <utility>
+
+namespace cqlite {
+
+    namespace {
+        /** The maximal number of sql texts whose route is remembered. */
+        const std::size_t MaxRoutes = 1024;
+
+        /**
+         * Whether the given sql begins, ends or nests a transaction. Sqlite considers
+         * these statements read-only, but they must run on the connection that writes.
+         */
+        bool controlsTransaction (const std::string& sql)
+        {
+            static const char* const Keywords[]
+                = {"BEGIN", "COMMIT", "END", "ROLLBACK", "SAVEPOINT", "RELEASE"};
+
+            std::string keyword;
+
+            for (char c : sql) {
+                const unsigned char character = static_cast<unsigned char> (c);
+
+                if (std::isalpha (character)) {
+                    keyword += static_cast<char> (std::toupper (character));
+                }
+                else if (! keyword.empty () || ! std::isspace (character)) {
+                    break;
+                }
+            }
+
+            for (const char* candidate : Keywords) {
+                if (keyword == candidate) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    } // namespace
+
+    PoolError::PoolError (const std::string& what) : Error {what} {}
+
+    PoolError::PoolError (const char* what) : Error {what} {}
+
+    DatabasePool::Lease::Lease (DatabasePool* pool, Database* db) : pool_ {pool}, db_ {db}
+    {}
+
+    DatabasePool::Lease::Lease (Lease&& other) : pool_ {other.pool_}, db_ {other.db_}
+    {
+        other.pool_ = nullptr;
+        other.db_ = nullptr;
+    }
+
+    DatabasePool::Lease& DatabasePool::Lease::operator= (Lease&& other)
+    {
+        if (this != &other) {
+            release ();
+
+            pool_ = other.pool_;
+            db_ = other.db_;
+
+            other.pool_ = nullptr;
+            other.db_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Returns the leased connection to its pool.
+     */
+    DatabasePool::Lease::~Lease () { release (); }
+
+    void DatabasePool::Lease::release ()
+    {
+        if (pool_) {
+            pool_->release (db_);
+
+            pool_ = nullptr;
+            db_ = nullptr;
+        }
+    }
+
+    /**
+     * Opens a pool of connections on the given file.
+     * The file is created if it does not already exist and it is switched to WAL mode,
+     * which is what allows the readers to proceed while the writer writes.
+     * @param path the path to the sqlite3 database file, in-memory databases cannot
+     * be shared between connections and are therefore not supported
+     * @param readers the number of read-only connections
+     * @throws DbError if one of the connections cannot be opened
+     * @throws PoolError if the database cannot be switched to WAL mode or if no readers
+     * are requested
+     */
+    DatabasePool::DatabasePool (const std::string& path, std::size_t readers) :
+        writer_ {path, Database::ReadWrite | Database::Create | Database::NoMutex},
+        readers_ {},
+        mutex_ {},
+        readerReleased_ {},
+        writerReleased_ {},
+        idle_ {},
+        writerIdle_ {true},
+        writerOwner_ {},
+        routes_ {}
+    {
+        if (readers == 0) {
+            throw PoolError {"A pool needs at least one reader"};
+        }
+
+        std::string mode;
+        writer_.prepare ("PRAGMA journal_mode = WAL").execute () >> mode;
+
+        if (mode != "wal") {
+            throw PoolError {"Unable to switch the database to WAL mode"};
+        }
+
+        // The readers are never moved after this point, leases refer to them directly.
+        readers_.reserve (readers);
+        idle_.reserve (readers);
+
+        for (std::size_t i = 0; i < readers; ++i) {
+            readers_.emplace_back (path, Database::ReadOnly | Database::NoMutex);
+            idle_.push_back (&readers_.back ());
+        }
+    }
+
+    /**
+     * Closes all connections.
+     * All leases must have been returned to the pool before it is destroyed.
+     */
+    DatabasePool::~DatabasePool () = default;
+
+    /**
+     * Leases one of the read-only connections, waits until one becomes available if
+     * all of them are in use.
+     * @return the lease of a reader
+     */
+    DatabasePool::Lease DatabasePool::reader ()
+    {
+        std::unique_lock<std::mutex> lock {mutex_};
+
+        readerReleased_.wait (lock, [this] { return ! idle_.empty (); });
+
+        Database* db = idle_.back ();
+        idle_.pop_back ();
+
+        return Lease {this, db};
+    }
+
+    /**
+     * Leases the writing connection, waits until it becomes available if it is in use.
+     * @return the lease of the writer
+     * @throws PoolError if the calling thread already holds the lease of the writer,
+     * which would never be returned while waiting for it
+     */
+    DatabasePool::Lease DatabasePool::writer ()
+    {
+        std::unique_lock<std::mutex> lock {mutex_};
+
+        if (! writerIdle_ && writerOwner_ == std::this_thread::get_id ()) {
+            throw PoolError {"The writer is already leased by the calling thread"};
+        }
+
+        writerReleased_.wait (lock, [this] { return writerIdle_; });
+        writerIdle_ = false;
+        writerOwner_ = std::this_thread::get_id ();
+
+        return Lease {this, &writer_};
+    }
+
+    /**
+     * Prepares the given sql on a connection that suits it.
+     * Statements that do not write to the database go to one of the readers, all the
+     * others go to the writer, and so do the statements that control transactions
+     * (BEGIN, COMMIT, SAVEPOINT etc.). The decision is remembered per sql text, so
+     * only the first preparation of a writing statement pays for a probe on a reader.
+     * Since the statement holds the lease of its connection, the statements of one
+     * transaction are prepared on a lease of the writer instead.
+     * @param sql the sql expression with optional placeholders (`?1`, `:name` etc.)
+     * @return the statement together with the lease of its connection
+     * @throws DbError if the given statement cannot be compiled
+     * @throws PoolError if the statement writes and the calling thread already holds
+     * the lease of the writer
+     */
+    PooledStatement DatabasePool::prepare (const std::string& sql)
+    {
+        if (route (sql) == Route::Unknown && controlsTransaction (sql)) {
+            route (sql, Route::Writer);
+        }
+
+        if (route (sql) != Route::Writer) {
+            Lease lease = reader ();
+            Statement statement = lease->prepare (sql);
+
+            if (statement.readOnly ()) {
+                route (sql, Route::Reader);
+                return PooledStatement {std::move (lease), std::move (statement)};
+            }
+
+            route (sql, Route::Writer);
+        }
+
+        Lease lease = writer ();
+        Statement statement = lease->prepare (sql);
+
+        return PooledStatement {std::move (lease), std::move (statement)};
+    }
+
+    /**
+     * The number of read-only connections in this pool.
+     * @return the number of readers
+     */
+    std::size_t DatabasePool::readers () const { return readers_.size (); }
+
+    void DatabasePool::release (Database* db)
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+
+            if (db == &writer_) {
+                writerIdle_ = true;
+                writerOwner_ = std::thread::id {};
+            }
+            else {
+                idle_.push_back (db);
+            }
+        }
+
+        if (db == &writer_) {
+            writerReleased_.notify_one ();
+        }
+        else {
+            readerReleased_.notify_one ();
+        }
+    }
+
+    DatabasePool::Route DatabasePool::route (const std::string& sql)
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+
+        auto at = routes_.find (sql);
+        return at == routes_.end () ? Route::Unknown : at->second;
+    }
+
+    void DatabasePool::route (const std::string& sql, Route route)
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+
+        // Applications that build their sql text dynamically would grow the routes
+        // forever, an arbitrary one is forgotten and probed again when needed.
+        if (routes_.size () >= MaxRoutes && routes_.count (sql) == 0) {
+            routes_.erase (routes_.begin ());
+        }
+
+        routes_[sql] = route;
+    }
+
+    PooledStatement::PooledStatement (
+        DatabasePool::Lease&& lease, Statement&& statement) :
+        lease_ {std::move (lease)}, statement_ {std::move (statement)}
+    {}
+
+    /**
+     * Takes over the statement and the lease of the given one.
+     * The statement held so far is finalized before its connection goes back to the
+     * pool, where another thread may already take it.
+     * @param other the statement to move from
+     * @return this statement
+     */
+    PooledStatement& PooledStatement::operator= (PooledStatement&& other)
+    {
+        if (this != &other) {
+            statement_ = std::move (other.statement_);
+            lease_ = std::move (other.lease_);
+        }
+
+        return *this;
+    }
+} // namespace cqlite
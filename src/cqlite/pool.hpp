@@ -0,0 +1,203 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * pool.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_POOL_INC
+#define CQLITE_POOL_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/error.hpp>
+#include <cqlite/statement.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cqlite {
+
+    class PooledStatement;
+
+    class CQLITE_EXPORT PoolError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit PoolError (const std::string&);
+        explicit PoolError (const char*);
+    };
+
+    /**
+     * A set of connections to one database file in WAL mode: one writer and a number
+     * of read-only readers.
+     *
+     * Every connection is used by at most one thread at a time, it is handed out as a
+     * Lease and returned to the pool when the lease goes out of scope. Since the
+     * connections are opened in multithreaded mode, readers never wait for each other.
+     *
+     * Every statement of prepare holds a lease of its own, so the statements of one
+     * writing transaction are prepared on a single lease of the writer instead:
+     * @code
+     DatabasePool::Lease writer = pool.writer ();
+     Transaction transaction {*writer, Transaction::Type::Immediate};
+
+     writer->prepare ("INSERT INTO authors (name) VALUES ('Sue')").execute ();
+     writer->prepare ("UPDATE stats SET authors = authors + 1").execute ();
+
+     transaction.commit ();
+     * @endcode
+     */
+    class CQLITE_EXPORT DatabasePool
+    {
+      public:
+        /**
+         * Exclusive access to one connection of a pool.
+         */
+        class CQLITE_EXPORT Lease
+        {
+          public:
+            ~Lease ();
+
+            Lease (const Lease&) = delete;
+            Lease& operator= (const Lease&) = delete;
+            Lease (Lease&&);
+            Lease& operator= (Lease&&);
+
+            Database& operator* () const;
+            Database* operator->() const;
+
+          private:
+            friend class DatabasePool;
+            Lease (DatabasePool*, Database*);
+
+            void release ();
+
+          private:
+            DatabasePool* pool_;
+            Database* db_;
+        };
+
+      public:
+        DatabasePool (const std::string&, std::size_t);
+        ~DatabasePool ();
+
+        DatabasePool (const DatabasePool&) = delete;
+        DatabasePool& operator= (const DatabasePool&) = delete;
+
+        Lease reader ();
+        Lease writer ();
+
+        PooledStatement prepare (const std::string&);
+
+        std::size_t readers () const;
+
+      private:
+        enum class Route
+        {
+            Unknown,
+            Reader,
+            Writer
+        };
+
+        void release (Database*);
+
+        Route route (const std::string&);
+        void route (const std::string&, Route);
+
+      private:
+        Database writer_;
+        std::vector<Database> readers_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable readerReleased_;
+        std::condition_variable writerReleased_;
+
+        std::vector<Database*> idle_;
+        bool writerIdle_;
+        std::thread::id writerOwner_;
+
+        std::unordered_map<std::string, Route> routes_;
+    };
+
+    /**
+     * A statement that was prepared on a pooled connection, together with the lease
+     * of that connection.
+     *
+     * The connection is returned to its pool when the statement goes out of scope.
+     */
+    class CQLITE_EXPORT PooledStatement
+    {
+      public:
+        PooledStatement (DatabasePool::Lease&&, Statement&&);
+
+        PooledStatement (PooledStatement&&) = default;
+        PooledStatement& operator= (PooledStatement&&);
+
+        Statement& operator* ();
+        Statement* operator->();
+
+        Database& database () const;
+
+      private:
+        // The declaration order matters: the statement must be finalized before its
+        // connection goes back to the pool.
+        DatabasePool::Lease lease_;
+        Statement statement_;
+    };
+
+    /**
+     * The connection this lease grants access to.
+     * @return the leased connection
+     */
+    inline Database& DatabasePool::Lease::operator* () const { return *db_; }
+
+    /**
+     * The connection this lease grants access to.
+     * @return the leased connection
+     */
+    inline Database* DatabasePool::Lease::operator->() const { return db_; }
+
+    /**
+     * The pooled statement.
+     * @return the statement
+     */
+    inline Statement& PooledStatement::operator* () { return statement_; }
+
+    /**
+     * The pooled statement.
+     * @return the statement
+     */
+    inline Statement* PooledStatement::operator->() { return &statement_; }
+
+    /**
+     * The connection the statement was prepared on.
+     * @return the leased connection
+     */
+    inline Database& PooledStatement::database () const { return *lease_; }
+} // namespace cqlite
+
+#endif /* CQLITE_POOL_INC */
@@ -23,16 +23,66 @@
  * under certain conditions.
  */
 #include <cqlite/code.hpp>
+#include <cqlite/columns.hpp>
+#include <cqlite/contention.hpp>
 #include <cqlite/error.hpp>
+#include <cqlite/metrics.hpp>
 #include <cqlite/result.hpp>
 
 #include <sqlite3.h>
 
-#include <chrono>
-#include <thread>
+#include <utility>
+#include <vector>
 
 namespace cqlite {
 
+    namespace detail {
+
+        /**
+         * Backs the views extracted from a result in debug builds.
+         * Instead of pointing to the column buffers of sqlite, the views point to copies
+         * that are overwritten and released as soon as the result advances. A view that
+         * is used after that shows garbage and is reported as a use after free by
+         * address sanitizers, rather than silently showing the next row.
+         */
+        struct ViewGuard
+        {
+            static constexpr unsigned char Poison = 0xdb;
+
+            std::vector<std::vector<unsigned char>> copies;
+
+            const void* copy (const void*, std::size_t);
+            void invalidate ();
+
+            ~ViewGuard ();
+        };
+
+        const void* ViewGuard::copy (const void* data, std::size_t size)
+        {
+            const unsigned char* const bytes = static_cast<const unsigned char*> (data);
+
+            copies.emplace_back (bytes, bytes + size);
+
+            return copies.back ().data ();
+        }
+
+        void ViewGuard::invalidate ()
+        {
+            for (auto& copy : copies) {
+                // volatile, so that the stores are not optimized away before the free
+                volatile unsigned char* at = copy.data ();
+
+                for (std::size_t i = 0; i < copy.size (); ++i) {
+                    at[i] = Poison;
+                }
+            }
+
+            copies.clear ();
+        }
+
+        ViewGuard::~ViewGuard () { invalidate (); }
+    } // namespace detail
+
     QueryError::QueryError (const std::string& what) : Error {what} {}
 
     QueryError::QueryError (const char* what) : Error {what} {}
@@ -44,7 +94,37 @@ namespace cqlite {
      * @param stmt the statement
      * @throws Error if stmt is null
      */
-    Result::Result (sqlite3_stmt* stmt) : stmt_ {stmt}, index_ {0}, state_ {SQLITE_ROW}
+    Result::Result (sqlite3_stmt* stmt) :
+        stmt_ {stmt},
+        index_ {0},
+        state_ {SQLITE_ROW},
+        stepped_ {false},
+        guard_ {},
+        contention_ {},
+        probe_ {nullptr}
+    {
+        if (stmt_ == nullptr) {
+            throw Error {"No valid statement given."};
+        }
+    }
+
+    /**
+     * Creates a new result from the given sqlite3 statement that waits for locked
+     * tables according to the given policy.
+     * @param stmt the statement
+     * @param contention the contention policy of the statement, may be null
+     * @param probe measures the steps, may be null
+     * @throws Error if stmt is null
+     */
+    Result::Result (sqlite3_stmt* stmt, std::shared_ptr<ContentionPolicy> contention,
+        StatementProbe* probe) :
+        stmt_ {stmt},
+        index_ {0},
+        state_ {SQLITE_ROW},
+        stepped_ {false},
+        guard_ {},
+        contention_ {std::move (contention)},
+        probe_ {probe}
     {
         if (stmt_ == nullptr) {
             throw Error {"No valid statement given."};
@@ -96,14 +176,30 @@ namespace cqlite {
     {
         if (*this) {
             int result;
-            std::size_t count {0};
+            using Clock = StatementProbe::Clock;
+            const Clock::time_point start = probe_ ? Clock::now () : Clock::time_point {};
+
+            // Busy databases are waited for by the busy handler. A locked table of a
+            // shared cache can only be waited for before the first row, since the
+            // statement has to be reset in order to try again.
+            while (Code::isLocked (result = sqlite3_step (stmt_)) && ! stepped_
+                   && contention_ && contention_->locked (sqlite3_db_handle (stmt_))) {
+                sqlite3_reset (stmt_);
+            }
 
-            while ((result = sqlite3_step (stmt_)) == SQLITE_BUSY && count++ < 5) {
-                std::this_thread::sleep_for (std::chrono::milliseconds {1});
+            stepped_ = true;
+
+            if (probe_) {
+                probe_->stepped (Clock::now () - start);
+            }
+
+            if (guard_) {
+                guard_->invalidate ();
             }
 
             if (Code::isError (result)) {
-                throw QueryError {sqlite3_errstr (result)};
+                // The message of the connection tells e.g. why a user function failed.
+                throw QueryError {sqlite3_errmsg (sqlite3_db_handle (stmt_))};
             }
 
             index_ = 0;
@@ -180,7 +276,53 @@ namespace cqlite {
 
         ++index_;
 
-        value = std::string {text, size};
+        if (text) {
+            value.assign (text, size);
+        }
+        else {
+            value.clear ();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Extracts a view of the text in the next column without copying it.
+     * The view points into the row and is only valid until this result advances.
+     * In debug builds, views that are used after that show garbage.
+     * @return this result
+     */
+    Result& Result::operator>> (std::string_view& value)
+    {
+        const char* text
+            = reinterpret_cast<const char*> (sqlite3_column_text (stmt_, index_));
+
+        std::size_t size
+            = static_cast<std::size_t> (sqlite3_column_bytes (stmt_, index_));
+
+        ++index_;
+
+        value = std::string_view {static_cast<const char*> (guard (text, size)), size};
+
+        return *this;
+    }
+
+    /**
+     * Extracts a view of the blob in the next column without copying it.
+     * The view points into the row and is only valid until this result advances.
+     * In debug builds, views that are used after that show garbage.
+     * @return this result
+     */
+    Result& Result::operator>> (BlobView& value)
+    {
+        const void* data = sqlite3_column_blob (stmt_, index_);
+
+        std::size_t size
+            = static_cast<std::size_t> (sqlite3_column_bytes (stmt_, index_));
+
+        ++index_;
+
+        value = BlobView {guard (data, size), size};
 
         return *this;
     }
@@ -236,12 +378,67 @@ namespace cqlite {
         return *this;
     }
 
+    /**
+     * Hands out the given column data for a view.
+     * @param data the column data
+     * @param size the size of the column data
+     * @return the given data or, in debug builds, a guarded copy of it
+     */
+    const void* Result::guard (const void* data, std::size_t size)
+    {
+#ifndef NDEBUG
+        if (data) {
+            if (! guard_) {
+                guard_ = std::make_shared<detail::ViewGuard> ();
+            }
+
+            data = guard_->copy (data, size);
+        }
+#else
+        static_cast<void> (size);
+#endif
+        return data;
+    }
+
     /**
      * Whether more rows are available.
      * @return true if more rows are available
      */
     Result::operator bool () const { return state_ == SQLITE_ROW; }
 
+    /**
+     * Reads up to the given number of rows, starting with the current one, column by
+     * column into the given batch, e.g.
+     * @code
+
+     cqlite::ColumnBatch batch;
+
+     for (cqlite::Result result = select.execute ();
+          result.fetchColumns (1024, batch) != 0;) {
+         const std::vector<double>& weights = batch[2].reals ();
+         ...
+     }
+
+     @endcode
+     * The previous contents of the batch are replaced. Afterwards this result is
+     * positioned on the first row that has not been read.
+     * @param batchSize the maximal number of rows to read
+     * @param batch the batch to fill
+     * @return the number of rows read, 0 at the end of the result
+     * @throws QueryError if the next row cannot be read
+     */
+    std::size_t Result::fetchColumns (std::size_t batchSize, ColumnBatch& batch)
+    {
+        batch.reset (columns ());
+
+        while (batch.rows () < batchSize && *this) {
+            batch.append (stmt_);
+            ++*this;
+        }
+
+        return batch.rows ();
+    }
+
     /**
      * Returns the type of the next available column within this result set.
      * @return the type of the next available column within this result set
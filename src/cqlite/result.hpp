@@ -28,11 +28,14 @@
 #include <cqlite/cqlite_export.hpp>
 #include <cqlite/datetime.hpp>
 #include <cqlite/error.hpp>
+#include <cqlite/view.hpp>
 
 #include <chrono>
 #include <cstddef>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -40,6 +43,16 @@ struct sqlite3_stmt;
 
 namespace cqlite {
 
+    class ColumnBatch;
+    class ContentionPolicy;
+    class Statement;
+    class StatementProbe;
+
+    namespace detail {
+        struct ColumnAccess;
+        struct ViewGuard;
+    } // namespace detail
+
     class CQLITE_EXPORT QueryError : public Error
     {
         using Base = Error;
@@ -78,17 +91,32 @@ namespace cqlite {
         Result& operator>> (std::int64_t&);
         Result& operator>> (double&);
         Result& operator>> (std::string&);
+        Result& operator>> (std::string_view&);
+        Result& operator>> (BlobView&);
         Result& operator>> (std::pair<const void*, std::size_t>&);
         Result& operator>> (std::tuple<const void*&, std::size_t&>);
         Result& operator>> (DateTime&);
 
+        std::size_t fetchColumns (std::size_t, ColumnBatch&);
+
         operator bool () const;
         Type type () const;
 
+      private:
+        friend class Statement;
+        friend struct detail::ColumnAccess;
+        Result (sqlite3_stmt*, std::shared_ptr<ContentionPolicy>, StatementProbe*);
+
+        const void* guard (const void*, std::size_t);
+
       private:
         sqlite3_stmt* stmt_;
         int index_;
         int state_;
+        bool stepped_;
+        std::shared_ptr<detail::ViewGuard> guard_;
+        std::shared_ptr<ContentionPolicy> contention_;
+        StatementProbe* probe_;
     };
 } // namespace cqlite
 
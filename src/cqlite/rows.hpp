@@ -0,0 +1,342 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * rows.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_ROWS_INC
+#define CQLITE_ROWS_INC
+
+#include <cqlite/datetime.hpp>
+#include <cqlite/result.hpp>
+#include <cqlite/view.hpp>
+
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cqlite {
+
+    namespace detail {
+
+        template <typename>
+        constexpr bool AlwaysFalse = false;
+
+        /**
+         * Grants the typed column readers access to the row of a result.
+         */
+        struct ColumnAccess
+        {
+            static sqlite3_stmt* statement (const Result& result) { return result.stmt_; }
+
+            static const void* guard (Result& result, const void* data, std::size_t size)
+            {
+                return result.guard (data, size);
+            }
+        };
+
+        template <typename T>
+        inline void readColumn (Result&, sqlite3_stmt*, int, T&)
+        {
+            static_assert (AlwaysFalse<T>, "There is no column reader for this type");
+        }
+
+        inline void readColumn (Result&, sqlite3_stmt* stmt, int column, int& value)
+        {
+            value = sqlite3_column_int (stmt, column);
+        }
+
+        inline void readColumn (Result&, sqlite3_stmt* stmt, int column, bool& value)
+        {
+            value = sqlite3_column_int (stmt, column) != 0;
+        }
+
+        inline void readColumn (
+            Result&, sqlite3_stmt* stmt, int column, std::int64_t& value)
+        {
+            value = static_cast<std::int64_t> (sqlite3_column_int64 (stmt, column));
+        }
+
+        inline void readColumn (
+            Result&, sqlite3_stmt* stmt, int column, std::size_t& value)
+        {
+            value = static_cast<std::size_t> (sqlite3_column_int64 (stmt, column));
+        }
+
+        inline void readColumn (Result&, sqlite3_stmt* stmt, int column, double& value)
+        {
+            value = sqlite3_column_double (stmt, column);
+        }
+
+        inline void readColumn (Result&, sqlite3_stmt* stmt, int column, DateTime& value)
+        {
+            value = DateTime {
+                DateTime::clock::duration {sqlite3_column_int64 (stmt, column)}};
+        }
+
+        inline void readColumn (
+            Result&, sqlite3_stmt* stmt, int column, std::string& value)
+        {
+            const char* text
+                = reinterpret_cast<const char*> (sqlite3_column_text (stmt, column));
+            const int size = sqlite3_column_bytes (stmt, column);
+
+            if (text) {
+                value.assign (text, static_cast<std::size_t> (size));
+            }
+            else {
+                value.clear ();
+            }
+        }
+
+        inline void readColumn (
+            Result& result, sqlite3_stmt* stmt, int column, std::string_view& value)
+        {
+            const char* text
+                = reinterpret_cast<const char*> (sqlite3_column_text (stmt, column));
+            const std::size_t size
+                = static_cast<std::size_t> (sqlite3_column_bytes (stmt, column));
+
+            value = std::string_view {
+                static_cast<const char*> (ColumnAccess::guard (result, text, size)),
+                size};
+        }
+
+        inline void readColumn (
+            Result& result, sqlite3_stmt* stmt, int column, BlobView& value)
+        {
+            const void* data = sqlite3_column_blob (stmt, column);
+            const std::size_t size
+                = static_cast<std::size_t> (sqlite3_column_bytes (stmt, column));
+
+            value = BlobView {ColumnAccess::guard (result, data, size), size};
+        }
+
+        template <typename T>
+        inline void readColumn (
+            Result& result, sqlite3_stmt* stmt, int column, std::optional<T>& value)
+        {
+            if (sqlite3_column_type (stmt, column) == SQLITE_NULL) {
+                value.reset ();
+            }
+            else {
+                readColumn (result, stmt, column, value.emplace ());
+            }
+        }
+
+        /** Whether rows of the given column types stay valid after the next row. */
+        template <typename... Columns>
+        constexpr bool AreOwning = ((! std::is_same_v<Columns, std::string_view>
+                                        && ! std::is_same_v<Columns, BlobView>)
+            && ...);
+    } // namespace detail
+
+    /**
+     * The rows of an executed statement as an input range of tuples.
+     *
+     * The types of the columns are fixed at compile time, every row is decoded by
+     * inlined calls of the corresponding sqlite3_column_* functions. Supported column
+     * types are int, bool, std::int64_t, std::size_t, double, DateTime, std::string,
+     * std::string_view, BlobView and std::optional of those for nullable columns. Views
+     * are valid until the next row is read.
+     * @see Statement::rows
+     */
+    template <typename... Columns>
+    class Rows
+    {
+      public:
+        using Row = std::tuple<Columns...>;
+
+        class Iterator
+        {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Row;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Row*;
+            using reference = const Row&;
+
+          public:
+            Iterator ();
+
+            reference operator* () const;
+            pointer operator->() const;
+
+            Iterator& operator++ ();
+            void operator++ (int);
+
+            bool operator== (const Iterator&) const;
+            bool operator!= (const Iterator&) const;
+
+          private:
+            friend class Rows;
+            explicit Iterator (Rows*);
+
+            bool atEnd () const;
+
+          private:
+            Rows* rows_;
+        };
+
+      public:
+        explicit Rows (Result&&);
+
+        Rows (const Rows&) = delete;
+        Rows& operator= (const Rows&) = delete;
+        Rows (Rows&&) = default;
+        Rows& operator= (Rows&&) = default;
+
+        Iterator begin ();
+        Iterator end ();
+
+      private:
+        void decode ();
+
+        template <std::size_t... Index>
+        void decode (std::index_sequence<Index...>);
+
+      private:
+        Result result_;
+        Row row_;
+    };
+
+    /**
+     * Takes over the given result, positioned on its first row (if any).
+     * @param result the result of the executed statement
+     */
+    template <typename... Columns>
+    inline Rows<Columns...>::Rows (Result&& result) :
+        result_ {std::move (result)}, row_ {}
+    {
+        decode ();
+    }
+
+    /**
+     * The current row.
+     * Since the range is a single pass range, all iterators share the same position.
+     * @return an iterator to the current row
+     */
+    template <typename... Columns>
+    inline typename Rows<Columns...>::Iterator Rows<Columns...>::begin ()
+    {
+        return Iterator {this};
+    }
+
+    /**
+     * The end of the rows.
+     * @return the end iterator
+     */
+    template <typename... Columns>
+    inline typename Rows<Columns...>::Iterator Rows<Columns...>::end ()
+    {
+        return Iterator {};
+    }
+
+    template <typename... Columns>
+    inline void Rows<Columns...>::decode ()
+    {
+        if (result_) {
+            decode (std::index_sequence_for<Columns...> {});
+        }
+    }
+
+    template <typename... Columns>
+    template <std::size_t... Index>
+    inline void Rows<Columns...>::decode (std::index_sequence<Index...>)
+    {
+        [[maybe_unused]] sqlite3_stmt* const stmt
+            = detail::ColumnAccess::statement (result_);
+
+        (detail::readColumn (
+             result_, stmt, static_cast<int> (Index), std::get<Index> (row_)),
+            ...);
+    }
+
+    template <typename... Columns>
+    inline Rows<Columns...>::Iterator::Iterator () : rows_ {nullptr}
+    {}
+
+    template <typename... Columns>
+    inline Rows<Columns...>::Iterator::Iterator (Rows* rows) : rows_ {rows}
+    {}
+
+    template <typename... Columns>
+    inline typename Rows<Columns...>::Iterator::reference
+        Rows<Columns...>::Iterator::operator* () const
+    {
+        return rows_->row_;
+    }
+
+    template <typename... Columns>
+    inline typename Rows<Columns...>::Iterator::pointer
+        Rows<Columns...>::Iterator::operator->() const
+    {
+        return &rows_->row_;
+    }
+
+    /**
+     * Advances to the next row and decodes it.
+     * @return this iterator
+     * @throws QueryError if the next row cannot be read
+     */
+    template <typename... Columns>
+    inline typename Rows<Columns...>::Iterator& Rows<Columns...>::Iterator::operator++ ()
+    {
+        ++rows_->result_;
+        rows_->decode ();
+
+        return *this;
+    }
+
+    template <typename... Columns>
+    inline void Rows<Columns...>::Iterator::operator++ (int)
+    {
+        ++*this;
+    }
+
+    template <typename... Columns>
+    inline bool Rows<Columns...>::Iterator::operator== (const Iterator& other) const
+    {
+        return atEnd () == other.atEnd ();
+    }
+
+    template <typename... Columns>
+    inline bool Rows<Columns...>::Iterator::operator!= (const Iterator& other) const
+    {
+        return ! (*this == other);
+    }
+
+    template <typename... Columns>
+    inline bool Rows<Columns...>::Iterator::atEnd () const
+    {
+        return rows_ == nullptr || ! rows_->result_;
+    }
+} // namespace cqlite
+
+#endif /* CQLITE_ROWS_INC */
@@ -0,0 +1,447 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * session.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/cqlite_config.hpp>
+#include <cqlite/session.hpp>
+
+#ifdef CQLITE_HAVE_SESSION
+#ifndef SQLITE_ENABLE_SESSION
+#define SQLITE_ENABLE_SESSION
+#endif
+#ifndef SQLITE_ENABLE_PREUPDATE_HOOK
+#define SQLITE_ENABLE_PREUPDATE_HOOK
+#endif
+#endif
+
+#include <sqlite3.h>
+
+#include <exception>
+#include <utility>
+
+namespace cqlite {
+
+    SessionError::SessionError (const std::string& what) : Error {what} {}
+
+    SessionError::SessionError (const char* what) : Error {what} {}
+
+    namespace {
+
+        const char* const NotSupported
+            = "The sqlite3 library has been built without the session extension";
+
+#ifdef CQLITE_HAVE_SESSION
+        void check (sqlite3* db, int result)
+        {
+            if (result != SQLITE_OK) {
+                throw SessionError {db ? sqlite3_errmsg (db) : sqlite3_errstr (result)};
+            }
+        }
+
+        /** Takes over a changeset allocated by sqlite. */
+        Changeset adopt (int size, void* data)
+        {
+            Changeset changeset {data, static_cast<std::size_t> (size)};
+            sqlite3_free (data);
+
+            return changeset;
+        }
+
+        int write (void* out, const void* data, int size)
+        {
+            try {
+                (*static_cast<const Session::Writer*> (out)) (
+                    BlobView {data, static_cast<std::size_t> (size)});
+            }
+            catch (...) {
+                return SQLITE_IOERR;
+            }
+
+            return SQLITE_OK;
+        }
+
+        int read (void* in, void* data, int* size)
+        {
+            try {
+                *size = static_cast<int> ((*static_cast<const Session::Reader*> (in)) (
+                    data, static_cast<std::size_t> (*size)));
+            }
+            catch (...) {
+                return SQLITE_IOERR;
+            }
+
+            return SQLITE_OK;
+        }
+
+        /** The conflict handler of one apply call and what it threw. */
+        struct Apply
+        {
+            const Session::ConflictHandler& handler;
+            std::exception_ptr error;
+        };
+
+        int resolve (void* context, int conflict, sqlite3_changeset_iter* at)
+        {
+            Apply* apply = static_cast<Apply*> (context);
+
+            if (! apply->handler || apply->error) {
+                return SQLITE_CHANGESET_ABORT;
+            }
+
+            Session::Conflict kind = Session::Conflict::Data;
+
+            switch (conflict) {
+                case SQLITE_CHANGESET_NOTFOUND:
+                    kind = Session::Conflict::NotFound;
+                    break;
+                case SQLITE_CHANGESET_CONFLICT:
+                    kind = Session::Conflict::Duplicate;
+                    break;
+                case SQLITE_CHANGESET_CONSTRAINT:
+                    kind = Session::Conflict::Constraint;
+                    break;
+                case SQLITE_CHANGESET_FOREIGN_KEY:
+                    kind = Session::Conflict::ForeignKey;
+                    break;
+                default:
+                    break;
+            }
+
+            const char* table = "";
+            int columns;
+            int operation;
+            int indirect;
+
+            if (conflict != SQLITE_CHANGESET_FOREIGN_KEY) {
+                sqlite3changeset_op (at, &table, &columns, &operation, &indirect);
+            }
+
+            try {
+                switch (apply->handler (kind, table)) {
+                    case Session::Resolution::Omit:
+                        return SQLITE_CHANGESET_OMIT;
+                    case Session::Resolution::Replace:
+                        return conflict == SQLITE_CHANGESET_DATA
+                                || conflict == SQLITE_CHANGESET_CONFLICT
+                            ? SQLITE_CHANGESET_REPLACE
+                            : SQLITE_CHANGESET_OMIT;
+                    default:
+                        return SQLITE_CHANGESET_ABORT;
+                }
+            }
+            catch (...) {
+                apply->error = std::current_exception ();
+                return SQLITE_CHANGESET_ABORT;
+            }
+        }
+
+        void finish (sqlite3* db, int result, const Apply& apply)
+        {
+            if (apply.error) {
+                std::rethrow_exception (apply.error);
+            }
+
+            if (result == SQLITE_ABORT) {
+                throw SessionError {"Applying the changes has been aborted"};
+            }
+
+            check (db, result);
+        }
+#endif
+    } // namespace
+
+    Changeset::Changeset () : bytes_ {} {}
+
+    /**
+     * A copy of the given changeset.
+     * @param data the first byte of the changeset
+     * @param size the size of the changeset in bytes
+     */
+    Changeset::Changeset (const void* data, std::size_t size) :
+        bytes_ (static_cast<const unsigned char*> (data),
+            static_cast<const unsigned char*> (data) + size)
+    {}
+
+    /**
+     * The binary representation, which can be sent to another host.
+     * @return the first byte
+     */
+    const void* Changeset::data () const { return bytes_.data (); }
+
+    /**
+     * The size of the binary representation.
+     * @return the number of bytes
+     */
+    std::size_t Changeset::size () const { return bytes_.size (); }
+
+    /**
+     * Whether there are no changes.
+     * @return true iff the changeset is empty
+     */
+    bool Changeset::empty () const { return bytes_.empty (); }
+
+    /**
+     * The changeset that reverts this one, which is not possible for patchsets.
+     * @return the inverted changeset
+     * @throws SessionError if the changeset cannot be inverted
+     */
+    Changeset Changeset::invert () const
+    {
+#ifdef CQLITE_HAVE_SESSION
+        int size = 0;
+        void* data = nullptr;
+
+        check (nullptr,
+            sqlite3changeset_invert (static_cast<int> (bytes_.size ()),
+                const_cast<unsigned char*> (bytes_.data ()), &size, &data));
+
+        return adopt (size, data);
+#else
+        throw SessionError {NotSupported};
+#endif
+    }
+
+    /**
+     * Starts a session on the given database, which records nothing until tables are
+     * attached.
+     * @param db the database to record the changes of
+     * @param schema the name of the schema, "main" or the name of an attached database
+     * @throws SessionError if the session cannot be created or sqlite has been built
+     * without the session extension
+     */
+    Session::Session (Database& db, const std::string& schema) : session_ {nullptr}
+    {
+#ifdef CQLITE_HAVE_SESSION
+        check (db.db_, sqlite3session_create (db.db_, schema.c_str (), &session_));
+#else
+        static_cast<void> (db);
+        static_cast<void> (schema);
+
+        throw SessionError {NotSupported};
+#endif
+    }
+
+    Session::~Session ()
+    {
+#ifdef CQLITE_HAVE_SESSION
+        if (session_) {
+            sqlite3session_delete (session_);
+        }
+#endif
+    }
+
+    Session::Session (Session&& other) : session_ {other.session_}
+    {
+        other.session_ = nullptr;
+    }
+
+    Session& Session::operator= (Session&& other)
+    {
+        std::swap (session_, other.session_);
+        return *this;
+    }
+
+    /**
+     * Records the changes of the given table.
+     * @param table the name of the table
+     * @return this session
+     * @throws SessionError if the table cannot be attached
+     */
+    Session& Session::attach (const std::string& table)
+    {
+#ifdef CQLITE_HAVE_SESSION
+        check (nullptr, sqlite3session_attach (session_, table.c_str ()));
+#else
+        static_cast<void> (table);
+#endif
+        return *this;
+    }
+
+    /**
+     * Records the changes of all tables.
+     * @return this session
+     * @throws SessionError if the tables cannot be attached
+     */
+    Session& Session::attachAll ()
+    {
+#ifdef CQLITE_HAVE_SESSION
+        check (nullptr, sqlite3session_attach (session_, nullptr));
+#endif
+        return *this;
+    }
+
+    /**
+     * Pauses or resumes the recording.
+     * @param enabled whether to record changes
+     * @return this session
+     */
+    Session& Session::enable (bool enabled)
+    {
+#ifdef CQLITE_HAVE_SESSION
+        sqlite3session_enable (session_, enabled ? 1 : 0);
+#else
+        static_cast<void> (enabled);
+#endif
+        return *this;
+    }
+
+    /**
+     * Whether no changes have been recorded.
+     * @return true iff the session has no changes
+     */
+    bool Session::empty () const
+    {
+#ifdef CQLITE_HAVE_SESSION
+        return sqlite3session_isempty (session_) != 0;
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * The recorded changes as a changeset.
+     * @return the changeset
+     * @throws SessionError if the changeset cannot be created
+     */
+    Changeset Session::changeset () const
+    {
+#ifdef CQLITE_HAVE_SESSION
+        int size = 0;
+        void* data = nullptr;
+
+        check (nullptr, sqlite3session_changeset (session_, &size, &data));
+
+        return adopt (size, data);
+#else
+        return Changeset {};
+#endif
+    }
+
+    /**
+     * The recorded changes as a patchset, which leaves out the original values of
+     * updated and deleted rows.
+     * @return the patchset
+     * @throws SessionError if the patchset cannot be created
+     */
+    Changeset Session::patchset () const
+    {
+#ifdef CQLITE_HAVE_SESSION
+        int size = 0;
+        void* data = nullptr;
+
+        check (nullptr, sqlite3session_patchset (session_, &size, &data));
+
+        return adopt (size, data);
+#else
+        return Changeset {};
+#endif
+    }
+
+    /**
+     * Streams the recorded changes as a changeset chunk by chunk, without creating
+     * the whole changeset in memory.
+     * @param writer receives the chunks
+     * @throws SessionError if the changeset cannot be created or the writer throws
+     */
+    void Session::changeset (const Writer& writer) const
+    {
+#ifdef CQLITE_HAVE_SESSION
+        check (nullptr,
+            sqlite3session_changeset_strm (
+                session_, &write, const_cast<Writer*> (&writer)));
+#else
+        static_cast<void> (writer);
+#endif
+    }
+
+    /**
+     * Streams the recorded changes as a patchset chunk by chunk.
+     * @param writer receives the chunks
+     * @throws SessionError if the patchset cannot be created or the writer throws
+     */
+    void Session::patchset (const Writer& writer) const
+    {
+#ifdef CQLITE_HAVE_SESSION
+        check (nullptr,
+            sqlite3session_patchset_strm (
+                session_, &write, const_cast<Writer*> (&writer)));
+#else
+        static_cast<void> (writer);
+#endif
+    }
+
+    /**
+     * Applies the given changeset or patchset to the given database within a
+     * transaction, which is rolled back if a conflict is resolved with
+     * Resolution::Abort.
+     * @param db the database
+     * @param changeset the changes
+     * @param handler decides about conflicts, all conflicts abort without a handler
+     * @throws SessionError if the changes cannot be applied or are aborted
+     */
+    void Session::apply (
+        Database& db, const Changeset& changeset, const ConflictHandler& handler)
+    {
+#ifdef CQLITE_HAVE_SESSION
+        Apply context {handler, nullptr};
+
+        const int result = sqlite3changeset_apply (db.db_,
+            static_cast<int> (changeset.size ()), const_cast<void*> (changeset.data ()),
+            nullptr, &resolve, &context);
+
+        finish (db.db_, result, context);
+#else
+        static_cast<void> (db);
+        static_cast<void> (changeset);
+        static_cast<void> (handler);
+
+        throw SessionError {NotSupported};
+#endif
+    }
+
+    /**
+     * Applies a streamed changeset or patchset to the given database, see above.
+     * @param db the database
+     * @param reader provides the chunks of the changes
+     * @param handler decides about conflicts, all conflicts abort without a handler
+     * @throws SessionError if the changes cannot be applied or are aborted
+     */
+    void Session::apply (
+        Database& db, const Reader& reader, const ConflictHandler& handler)
+    {
+#ifdef CQLITE_HAVE_SESSION
+        Apply context {handler, nullptr};
+
+        const int result = sqlite3changeset_apply_strm (db.db_, &read,
+            const_cast<Reader*> (&reader), nullptr, &resolve, &context);
+
+        finish (db.db_, result, context);
+#else
+        static_cast<void> (db);
+        static_cast<void> (reader);
+        static_cast<void> (handler);
+
+        throw SessionError {NotSupported};
+#endif
+    }
+} // namespace cqlite
@@ -0,0 +1,165 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * session.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_SESSION_INC
+#define CQLITE_SESSION_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/error.hpp>
+#include <cqlite/view.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct sqlite3_session;
+
+namespace cqlite {
+
+    class CQLITE_EXPORT SessionError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit SessionError (const std::string&);
+        explicit SessionError (const char*);
+    };
+
+    /**
+     * The recorded changes of a session, either as a changeset, which carries the
+     * original values of the changed rows, or as a more compact patchset.
+     */
+    class CQLITE_EXPORT Changeset
+    {
+      public:
+        Changeset ();
+        Changeset (const void*, std::size_t);
+
+        const void* data () const;
+        std::size_t size () const;
+        bool empty () const;
+
+        Changeset invert () const;
+
+      private:
+        std::vector<unsigned char> bytes_;
+    };
+
+    /**
+     * Records the changes of a connection on chosen tables with the session extension
+     * of sqlite, e.g. in order to replicate them to another database.
+     * @code
+
+     cqlite::Session session {db};
+     session.attach ("things");
+
+     db << "UPDATE things SET name = 'Thing' WHERE id = 42";
+
+     cqlite::Session::apply (replica, session.changeset ());
+
+     @endcode
+     * Only tables with a primary key are recorded. The session must be destroyed
+     * before its database.
+     */
+    class CQLITE_EXPORT Session
+    {
+      public:
+        /** The kinds of conflicts that occur when a change is applied. */
+        enum class Conflict
+        {
+            /** The row to update or delete has other values than expected */
+            Data,
+            /** The row to update or delete does not exist */
+            NotFound,
+            /** The row to insert already exists */
+            Duplicate,
+            /** A change violates a constraint */
+            Constraint,
+            /** The changes leave foreign key violations behind */
+            ForeignKey
+        };
+
+        /** How to resolve a conflict. */
+        enum class Resolution
+        {
+            /** Skip the conflicting change */
+            Omit,
+            /** Overwrite the existing row, which is only possible for Data and
+             * Duplicate, for the others it is the same as Omit */
+            Replace,
+            /** Roll back all the changes applied so far */
+            Abort
+        };
+
+        /**
+         * Decides how a conflict is resolved.
+         * @param conflict the kind of the conflict
+         * @param table the table of the conflicting change
+         */
+        using ConflictHandler
+            = std::function<Resolution (Conflict conflict, std::string_view table)>;
+
+        /** Receives the next chunk of a streamed changeset. */
+        using Writer = std::function<void (BlobView chunk)>;
+
+        /**
+         * Provides the next chunk of a streamed changeset.
+         * @param buffer the memory to fill
+         * @param size the size of the buffer
+         * @return the number of bytes provided, 0 at the end of the changeset
+         */
+        using Reader = std::function<std::size_t (void* buffer, std::size_t size)>;
+
+      public:
+        explicit Session (Database&, const std::string& = "main");
+        ~Session ();
+
+        Session (const Session&) = delete;
+        Session& operator= (const Session&) = delete;
+        Session (Session&&);
+        Session& operator= (Session&&);
+
+        Session& attach (const std::string&);
+        Session& attachAll ();
+        Session& enable (bool);
+
+        bool empty () const;
+
+        Changeset changeset () const;
+        Changeset patchset () const;
+        void changeset (const Writer&) const;
+        void patchset (const Writer&) const;
+
+        static void apply (Database&, const Changeset&, const ConflictHandler& = {});
+        static void apply (Database&, const Reader&, const ConflictHandler& = {});
+
+      private:
+        sqlite3_session* session_;
+    };
+} // namespace cqlite
+
+#endif /* CQLITE_SESSION_INC */
@@ -0,0 +1,76 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * snapshot.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/cqlite_config.hpp>
+#include <cqlite/snapshot.hpp>
+
+#include <sqlite3.h>
+
+#include <utility>
+
+namespace cqlite {
+
+    SnapshotError::SnapshotError (const std::string& what) : Error {what} {}
+
+    SnapshotError::SnapshotError (const char* what) : Error {what} {}
+
+    Snapshot::Snapshot (sqlite3_snapshot* snapshot) : snapshot_ {snapshot} {}
+
+    Snapshot::~Snapshot ()
+    {
+#ifdef CQLITE_HAVE_SNAPSHOT
+        if (snapshot_) {
+            sqlite3_snapshot_free (snapshot_);
+        }
+#endif
+    }
+
+    Snapshot::Snapshot (Snapshot&& other) : snapshot_ {other.snapshot_}
+    {
+        other.snapshot_ = nullptr;
+    }
+
+    Snapshot& Snapshot::operator= (Snapshot&& other)
+    {
+        std::swap (snapshot_, other.snapshot_);
+        return *this;
+    }
+
+    /**
+     * Whether this snapshot is older than the given one.
+     * Both snapshots must be taken from the same database file, since its last
+     * checkpoint that restarted the WAL file.
+     * @param other the other snapshot
+     * @return true iff this snapshot has been taken before the other one
+     */
+    bool Snapshot::operator< (const Snapshot& other) const
+    {
+#ifdef CQLITE_HAVE_SNAPSHOT
+        return sqlite3_snapshot_cmp (snapshot_, other.snapshot_) < 0;
+#else
+        static_cast<void> (other);
+        return false;
+#endif
+    }
+} // namespace cqlite
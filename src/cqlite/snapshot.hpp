@@ -0,0 +1,74 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * snapshot.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_SNAPSHOT_INC
+#define CQLITE_SNAPSHOT_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/error.hpp>
+
+#include <string>
+
+struct sqlite3_snapshot;
+
+namespace cqlite {
+
+    class CQLITE_EXPORT SnapshotError : public Error
+    {
+        using Base = Error;
+
+      public:
+        explicit SnapshotError (const std::string&);
+        explicit SnapshotError (const char*);
+    };
+
+    /**
+     * A committed state of a database in WAL mode, which read transactions of other
+     * connections on the same file can be opened on, so that they all see exactly the
+     * same data.
+     * @see Database::snapshot
+     * @see Database::openSnapshot
+     */
+    class CQLITE_EXPORT Snapshot
+    {
+      public:
+        ~Snapshot ();
+
+        Snapshot (const Snapshot&) = delete;
+        Snapshot& operator= (const Snapshot&) = delete;
+        Snapshot (Snapshot&&);
+        Snapshot& operator= (Snapshot&&);
+
+        bool operator< (const Snapshot&) const;
+
+      private:
+        friend class Database;
+        explicit Snapshot (sqlite3_snapshot*);
+
+      private:
+        sqlite3_snapshot* snapshot_;
+    };
+} // namespace cqlite
+
+#endif /* CQLITE_SNAPSHOT_INC */
@@ -22,11 +22,16 @@
  * This is free software, and you are welcome to redistribute it
  * under certain conditions.
  */
+#include <cqlite/cache.hpp>
+#include <cqlite/code.hpp>
+#include <cqlite/contention.hpp>
 #include <cqlite/datetime.hpp>
 #include <cqlite/statement.hpp>
 
 #include <sqlite3.h>
 
+#include <utility>
+
 namespace cqlite {
 
     namespace {
@@ -53,14 +58,45 @@ namespace cqlite {
      * @param stmt the corresponding sqlite3 statement
      * @throws StatementError if statement is null
      */
-    Statement::Statement (sqlite3_stmt* stmt) : stmt_ {stmt}, index_ {0}
+    Statement::Statement (sqlite3_stmt* stmt) :
+        stmt_ {stmt},
+        index_ {0},
+        parameters_ {},
+        cache_ {},
+        contention_ {},
+        probe_ {}
+    {
+        if (! stmt_) {
+            throw StatementError {"No valid statement given"};
+        }
+    }
+
+    /**
+     * Constructs a new statement that leases the given sqlite3 statement from a cache.
+     * @param stmt the corresponding sqlite3 statement
+     * @param cache the cache the statement is handed back to when this is destroyed
+     * @throws StatementError if statement is null
+     */
+    Statement::Statement (sqlite3_stmt* stmt, std::weak_ptr<StatementCache> cache) :
+        stmt_ {stmt},
+        index_ {0},
+        parameters_ {},
+        cache_ {std::move (cache)},
+        contention_ {},
+        probe_ {}
     {
         if (! stmt_) {
             throw StatementError {"No valid statement given"};
         }
     }
 
-    Statement::Statement (Statement&& other) : stmt_ {other.stmt_}, index_ {other.index_}
+    Statement::Statement (Statement&& other) :
+        stmt_ {other.stmt_},
+        index_ {other.index_},
+        parameters_ {std::move (other.parameters_)},
+        cache_ {std::move (other.cache_)},
+        contention_ {std::move (other.contention_)},
+        probe_ {std::move (other.probe_)}
     {
         other.stmt_ = nullptr;
         other.index_ = 0;
@@ -69,12 +105,14 @@ namespace cqlite {
     Statement& Statement::operator= (Statement&& other)
     {
         if (this != &other) {
-            if (stmt_) {
-                sqlite3_finalize (stmt_);
-            }
+            release ();
 
             stmt_ = other.stmt_;
             index_ = other.index_;
+            parameters_ = std::move (other.parameters_);
+            cache_ = std::move (other.cache_);
+            contention_ = std::move (other.contention_);
+            probe_ = std::move (other.probe_);
 
             other.stmt_ = nullptr;
             other.index_ = 0;
@@ -86,7 +124,28 @@ namespace cqlite {
     /**
      * Cleans up the underlying sqlite3 statement
      */
-    Statement::~Statement () { sqlite3_finalize (stmt_); }
+    Statement::~Statement () { release (); }
+
+    /**
+     * Hands the underlying statement back to its cache or finalizes it, if it has none
+     * or if the cache no longer exists.
+     */
+    void Statement::release ()
+    {
+        if (stmt_) {
+            if (probe_) {
+                probe_->flush (stmt_);
+            }
+
+            std::shared_ptr<StatementCache> cache = cache_.lock ();
+
+            if (! cache || ! cache->checkin (stmt_)) {
+                sqlite3_finalize (stmt_);
+            }
+
+            stmt_ = nullptr;
+        }
+    }
 
     /**
      * Binds a blob.
@@ -95,111 +154,439 @@ namespace cqlite {
      * @throws StatementError if the given blob cannot be bound
      */
     Statement& Statement::operator<< (const std::tuple<const void*, std::size_t>& blob)
+    {
+        return bind (++index_, blob);
+    }
+
+    /**
+     * Binds a double.
+     * @param value the value to bind
+     * @return this statement
+     * @throws StatementError if the given value cannot be bound
+     */
+    Statement& Statement::operator<< (double value) { return bind (++index_, value); }
+
+    /**
+     * Binds a signed integer.
+     * @param value the value to bind
+     * @return this statement
+     * @throws StatementError if the given value cannot be bound
+     */
+    Statement& Statement::operator<< (int value) { return bind (++index_, value); }
+
+    /**
+     * Binds an std::size_t.
+     * @param value the value to bind
+     * @return this statement
+     * @throws StatementError if the given value cannot be bound
+     */
+    Statement& Statement::operator<< (std::size_t value)
+    {
+        return bind (++index_, value);
+    }
+
+    /**
+     * Binds a 64-bit signed integer.
+     * @param value the value to bind
+     * @return this statement
+     * @throws StatementError if the given value cannot be bound
+     */
+    Statement& Statement::operator<< (std::int64_t value)
+    {
+        return bind (++index_, value);
+    }
+
+    /**
+     * Binds null.
+     * @return this statement
+     * @throws StatementError if null cannot be bound
+     */
+    Statement& Statement::operator<< (std::nullptr_t)
+    {
+        return bind (++index_, nullptr);
+    }
+
+    /**
+     * Binds a string.
+     * @param value the string to bind
+     * @return this statement
+     * @throws StatementError if the given string cannot be bound
+     */
+    Statement& Statement::operator<< (const std::string& value)
+    {
+        return bind (++index_, value);
+    }
+
+    /**
+     * Binds a string view.
+     * The viewed text is copied, use borrow if it is known to outlive the binding.
+     * @param value the text to bind
+     * @return this statement
+     * @throws StatementError if the given text cannot be bound
+     */
+    Statement& Statement::operator<< (std::string_view value)
+    {
+        return bind (++index_, value);
+    }
+
+    /**
+     * Binds a null terminated string.
+     * @param value the string to bind, null is bound as null
+     * @return this statement
+     * @throws StatementError if the given string cannot be bound
+     */
+    Statement& Statement::operator<< (const char* value)
+    {
+        return bind (++index_, value);
+    }
+
+    /**
+     * Binds a blob.
+     * The viewed data is copied, use borrow if it is known to outlive the binding.
+     * @param blob the blob to bind
+     * @return this statement
+     * @throws StatementError if the given blob cannot be bound
+     */
+    Statement& Statement::operator<< (BlobView blob) { return bind (++index_, blob); }
+
+    /**
+     * Binds a string without copying it.
+     * @param value the borrowed text to bind
+     * @return this statement
+     * @throws StatementError if the given text cannot be bound
+     * @see borrow
+     */
+    Statement& Statement::operator<< (Borrowed<std::string_view> value)
+    {
+        return bind (++index_, value);
+    }
+
+    /**
+     * Binds a blob without copying it.
+     * @param blob the borrowed blob to bind
+     * @return this statement
+     * @throws StatementError if the given blob cannot be bound
+     * @see borrow
+     */
+    Statement& Statement::operator<< (Borrowed<BlobView> blob)
+    {
+        return bind (++index_, blob);
+    }
+
+    /**
+     * Binds a std::chrono::time_point<std::chrono::system_clock>
+     * @param dateTime the time_point to bind
+     * @return this statement
+     * @throws StatementError if the given string cannot be bound
+     */
+    Statement& Statement::operator<< (const DateTime& dateTime)
+    {
+        return bind (++index_, dateTime);
+    }
+
+    /**
+     * Binds an array without copying it, to be read with the table valued function
+     * cqlite_array.
+     * @param array the borrowed array to bind
+     * @return this statement
+     * @throws StatementError if the given array cannot be bound
+     * @see ArrayView
+     */
+    Statement& Statement::operator<< (const ArrayView& array)
+    {
+        return bind (++index_, array);
+    }
+
+    /**
+     * Binds a blob of zeros without allocating it.
+     * @param blob the size of the blob
+     * @return this statement
+     * @throws StatementError if the blob cannot be bound, e.g. if it is too big
+     * @see BlobStream
+     */
+    Statement& Statement::operator<< (ZeroBlob blob) { return bind (++index_, blob); }
+
+    /**
+     * Binds a blob to the parameter with the given index.
+     * Binding by index leaves the position of the stream operators untouched.
+     * @param index the index of the parameter, starting at 1, ?NNN has the index NNN
+     * @param blob a pair that holds the data and the size of the blob to be bound
+     * @return this statement
+     * @throws StatementError if the given blob cannot be bound
+     */
+    Statement& Statement::bind (
+        int index, const std::tuple<const void*, std::size_t>& blob)
     {
         handleResult (sqlite3_bind_blob64 (
-            stmt_, ++index_, std::get<0> (blob), std::get<1> (blob), SQLITE_TRANSIENT));
+            stmt_, index, std::get<0> (blob), std::get<1> (blob), SQLITE_TRANSIENT));
 
         return *this;
     }
 
     /**
-     * Binds a double.
+     * Binds a double to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
      * @param value the value to bind
      * @return this statement
      * @throws StatementError if the given value cannot be bound
      */
-    Statement& Statement::operator<< (double value)
+    Statement& Statement::bind (int index, double value)
     {
-        handleResult (sqlite3_bind_double (stmt_, ++index_, value));
+        handleResult (sqlite3_bind_double (stmt_, index, value));
 
         return *this;
     }
 
     /**
-     * Binds a signed integer.
+     * Binds a signed integer to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
      * @param value the value to bind
      * @return this statement
      * @throws StatementError if the given value cannot be bound
      */
-    Statement& Statement::operator<< (int value)
+    Statement& Statement::bind (int index, int value)
     {
-        handleResult (sqlite3_bind_int (stmt_, ++index_, value));
+        handleResult (sqlite3_bind_int (stmt_, index, value));
 
         return *this;
     }
 
     /**
-     * Binds an std::size_t.
+     * Binds an std::size_t to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
      * @param value the value to bind
      * @return this statement
      * @throws StatementError if the given value cannot be bound
      */
-    Statement& Statement::operator<< (std::size_t value)
+    Statement& Statement::bind (int index, std::size_t value)
     {
         handleResult (
-            sqlite3_bind_int64 (stmt_, ++index_, static_cast<std::int64_t> (value)));
+            sqlite3_bind_int64 (stmt_, index, static_cast<std::int64_t> (value)));
 
         return *this;
     }
 
     /**
-     * Binds a 64-bit signed integer.
+     * Binds a 64-bit signed integer to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
      * @param value the value to bind
      * @return this statement
      * @throws StatementError if the given value cannot be bound
      */
-    Statement& Statement::operator<< (std::int64_t value)
+    Statement& Statement::bind (int index, std::int64_t value)
     {
-        handleResult (sqlite3_bind_int64 (stmt_, ++index_, value));
+        handleResult (sqlite3_bind_int64 (stmt_, index, value));
 
         return *this;
     }
 
     /**
-     * Binds null.
+     * Binds null to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
      * @return this statement
      * @throws StatementError if null cannot be bound
      */
-    Statement& Statement::operator<< (std::nullptr_t)
+    Statement& Statement::bind (int index, std::nullptr_t)
     {
-        handleResult (sqlite3_bind_null (stmt_, ++index_));
+        handleResult (sqlite3_bind_null (stmt_, index));
 
         return *this;
     }
 
     /**
-     * Binds a string.
+     * Binds a string to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
      * @param value the string to bind
      * @return this statement
      * @throws StatementError if the given string cannot be bound
      */
-    Statement& Statement::operator<< (const std::string& value)
+    Statement& Statement::bind (int index, const std::string& value)
     {
-        handleResult (sqlite3_bind_text64 (stmt_, ++index_, value.c_str (), value.size (),
-            SQLITE_TRANSIENT, SQLITE_UTF8));
+        return bind (index, std::string_view {value});
+    }
+
+    /**
+     * Binds a string view to the parameter with the given index.
+     * The viewed text is copied, use borrow if it is known to outlive the binding.
+     * @param index the index of the parameter, starting at 1
+     * @param value the text to bind
+     * @return this statement
+     * @throws StatementError if the given text cannot be bound
+     */
+    Statement& Statement::bind (int index, std::string_view value)
+    {
+        // An empty view may not point anywhere, which would be bound as null.
+        const char* const text = value.data () ? value.data () : "";
+
+        handleResult (sqlite3_bind_text64 (
+            stmt_, index, text, value.size (), SQLITE_TRANSIENT, SQLITE_UTF8));
 
         return *this;
     }
 
     /**
-     * Binds a std::chrono::time_point<std::chrono::system_clock>
-     * @param dateTime the time_point to bind
+     * Binds a null terminated string to the parameter with the given index.
+     * @param index the index of the parameter, starting at 1
+     * @param value the string to bind, null is bound as null
      * @return this statement
      * @throws StatementError if the given string cannot be bound
      */
-    Statement& Statement::operator<< (const DateTime& dateTime)
+    Statement& Statement::bind (int index, const char* value)
+    {
+        if (value == nullptr) {
+            return bind (index, nullptr);
+        }
+
+        return bind (index, std::string_view {value});
+    }
+
+    /**
+     * Binds a blob to the parameter with the given index.
+     * The viewed data is copied, use borrow if it is known to outlive the binding.
+     * @param index the index of the parameter, starting at 1
+     * @param blob the blob to bind
+     * @return this statement
+     * @throws StatementError if the given blob cannot be bound
+     */
+    Statement& Statement::bind (int index, BlobView blob)
+    {
+        // An empty view may not point anywhere, which would be bound as null.
+        const void* const data = blob.data () ? blob.data () : "";
+
+        handleResult (
+            sqlite3_bind_blob64 (stmt_, index, data, blob.size (), SQLITE_TRANSIENT));
+
+        return *this;
+    }
+
+    /**
+     * Binds a string to the parameter with the given index without copying it.
+     * @param index the index of the parameter, starting at 1
+     * @param value the borrowed text to bind
+     * @return this statement
+     * @throws StatementError if the given text cannot be bound
+     * @see borrow
+     */
+    Statement& Statement::bind (int index, Borrowed<std::string_view> value)
+    {
+        const char* const text = value.view.data () ? value.view.data () : "";
+
+        handleResult (sqlite3_bind_text64 (
+            stmt_, index, text, value.view.size (), SQLITE_STATIC, SQLITE_UTF8));
+
+        return *this;
+    }
+
+    /**
+     * Binds a blob to the parameter with the given index without copying it.
+     * @param index the index of the parameter, starting at 1
+     * @param blob the borrowed blob to bind
+     * @return this statement
+     * @throws StatementError if the given blob cannot be bound
+     * @see borrow
+     */
+    Statement& Statement::bind (int index, Borrowed<BlobView> blob)
+    {
+        const void* const data = blob.view.data () ? blob.view.data () : "";
+
+        handleResult (
+            sqlite3_bind_blob64 (stmt_, index, data, blob.view.size (), SQLITE_STATIC));
+
+        return *this;
+    }
+
+    /**
+     * Binds a std::chrono::time_point<std::chrono::system_clock> to the parameter with
+     * the given index.
+     * @param index the index of the parameter, starting at 1
+     * @param dateTime the time_point to bind
+     * @return this statement
+     * @throws StatementError if the given value cannot be bound
+     */
+    Statement& Statement::bind (int index, const DateTime& dateTime)
     {
         handleResult (
-            sqlite3_bind_int64 (stmt_, ++index_, dateTime.time_since_epoch ().count ()));
+            sqlite3_bind_int64 (stmt_, index, dateTime.time_since_epoch ().count ()));
+
+        return *this;
+    }
+
+    /**
+     * Binds an array to the parameter with the given index without copying it.
+     * @param index the index of the parameter, starting at 1
+     * @param array the borrowed array to bind
+     * @return this statement
+     * @throws StatementError if the given array cannot be bound
+     * @see ArrayView
+     */
+    Statement& Statement::bind (int index, const ArrayView& array)
+    {
+        handleResult (detail::bindArray (stmt_, index, array));
+
+        return *this;
+    }
+
+    /**
+     * Binds a blob of zeros to the parameter with the given index without allocating
+     * it.
+     * @param index the index of the parameter, starting at 1
+     * @param blob the size of the blob
+     * @return this statement
+     * @throws StatementError if the blob cannot be bound, e.g. if it is too big
+     */
+    Statement& Statement::bind (int index, ZeroBlob blob)
+    {
+        handleResult (sqlite3_bind_zeroblob64 (stmt_, index, blob.size));
+
+        return *this;
+    }
+
+    /**
+     * The index of the parameter with the given name.
+     * The names are resolved once per statement and kept for the next lookups.
+     * @param name the name of the parameter including its prefix, e.g. ":id"
+     * @return the index of the parameter
+     * @throws StatementError if the statement has no parameter with the given name
+     */
+    int Statement::parameter (std::string_view name)
+    {
+        for (const auto& [known, index] : parameters_) {
+            if (known == name) {
+                return index;
+            }
+        }
+
+        const std::string key {name};
+        const int index = sqlite3_bind_parameter_index (stmt_, key.c_str ());
+
+        if (index == 0) {
+            throw StatementError {"The statement has no parameter named " + key};
+        }
+
+        parameters_.emplace_back (key, index);
+
+        return index;
+    }
+
+    /**
+     * Sets all the parameters of this statement to null.
+     * Unlike reset, which keeps the bound values, this allows to start a run of
+     * bindings from scratch, whereas parameters that stay the same for a number of
+     * executions are bound only once and kept across resets.
+     * @return this statement
+     */
+    Statement& Statement::clearBindings ()
+    {
+        sqlite3_clear_bindings (stmt_);
 
         return *this;
     }
 
     /**
      * Resets the statement.
-     * This resets all parameters previously bound and rewinds the binding to the first
-     * parameter. This method comes in in loops, when parameters are bound subsequently
-     * with multiple entities. E.g.
+     * This rewinds the binding to the first parameter, the values bound previously stay
+     * bound until they are bound again or cleared with clearBindings. This method comes
+     * in in loops, when parameters are bound subsequently with multiple entities. E.g.
      * @code
 
      std::vector<Thing> things;
@@ -213,6 +600,7 @@ namespace cqlite {
      }
 
      @endcode
+     * The same loop is available as executeMany, which also wraps it in a transaction.
      @return this statement
      */
     Statement& Statement::reset ()
@@ -229,9 +617,199 @@ namespace cqlite {
      */
     Result Statement::execute ()
     {
-        Result result {stmt_};
+        if (probe_) {
+            probe_->flush (stmt_);
+            probe_->executed ();
+        }
+
+        Result result {stmt_, contention_, probe_.get ()};
         ++result;
         return result;
     }
+
+    /**
+     * Prepares a run of executeMany.
+     * A transaction is begun, unless the connection is already within one.
+     * @param stmt the statement that is executed
+     * @param contention the contention policy of the statement, if any
+     * @param probe the probe measuring the statement, if any
+     * @param commitEvery the number of rows per transaction, 0 for one transaction
+     * @throws QueryError if the transaction cannot be begun
+     */
+    Statement::Batch::Batch (sqlite3_stmt* stmt, ContentionPolicy* contention,
+        StatementProbe* probe, std::size_t commitEvery) :
+        stmt_ {stmt},
+        contention_ {contention},
+        probe_ {probe},
+        commitEvery_ {commitEvery},
+        pending_ {0},
+        changes_ {0},
+        owned_ {sqlite3_get_autocommit (sqlite3_db_handle (stmt)) != 0},
+        active_ {false}
+    {
+        begin ();
+    }
+
+    /**
+     * Rolls back the transaction if the run did not finish.
+     */
+    Statement::Batch::~Batch ()
+    {
+        if (active_) {
+            sqlite3_exec (
+                sqlite3_db_handle (stmt_), "ROLLBACK", nullptr, nullptr, nullptr);
+        }
+    }
+
+    /**
+     * Executes the statement with its current bindings.
+     * @throws QueryError if the statement fails or the transaction cannot be committed
+     */
+    void Statement::Batch::step ()
+    {
+        int result;
+        using Clock = StatementProbe::Clock;
+        const Clock::time_point start = probe_ ? Clock::now () : Clock::time_point {};
+
+        sqlite3* const db = sqlite3_db_handle (stmt_);
+        const int before = sqlite3_total_changes (db);
+
+        // Every row is a fresh execution, so it can be reset and retried.
+        while (Code::isLocked (result = sqlite3_step (stmt_)) && contention_
+               && contention_->locked (db)) {
+            sqlite3_reset (stmt_);
+        }
+
+        // The rows of RETURNING are skipped, the statement only counts once it is done.
+        while (result == SQLITE_ROW) {
+            result = sqlite3_step (stmt_);
+        }
+
+        if (probe_) {
+            probe_->executed ();
+            probe_->stepped (Clock::now () - start);
+        }
+
+        if (Code::isError (result)) {
+            throw QueryError {sqlite3_errmsg (db)};
+        }
+
+        // sqlite3_changes keeps the count of the last statement that changed rows, so it
+        // is only taken if this one did, e.g. not for a SELECT or a CREATE.
+        if (sqlite3_total_changes (db) != before) {
+            changes_ += static_cast<std::size_t> (sqlite3_changes (db));
+        }
+
+        if (commitEvery_ > 0 && ++pending_ == commitEvery_) {
+            commit ();
+            begin ();
+        }
+    }
+
+    /**
+     * Commits the remaining rows.
+     * @return the number of rows changed by the whole run
+     * @throws QueryError if the transaction cannot be committed
+     */
+    std::size_t Statement::Batch::finish ()
+    {
+        commit ();
+        return changes_;
+    }
+
+    void Statement::Batch::begin ()
+    {
+        if (owned_) {
+            char* errstr = nullptr;
+            int result = sqlite3_exec (
+                sqlite3_db_handle (stmt_), "BEGIN IMMEDIATE", nullptr, nullptr, &errstr);
+
+            if (Code::isError (result)) {
+                std::string errmsg {errstr ? errstr : sqlite3_errstr (result)};
+                sqlite3_free (errstr);
+
+                throw QueryError {errmsg};
+            }
+
+            active_ = true;
+        }
+
+        pending_ = 0;
+    }
+
+    void Statement::Batch::commit ()
+    {
+        if (active_) {
+            // The statement may still hold a read transaction, e.g. with RETURNING.
+            sqlite3_reset (stmt_);
+
+            char* errstr = nullptr;
+            int result = sqlite3_exec (
+                sqlite3_db_handle (stmt_), "COMMIT", nullptr, nullptr, &errstr);
+
+            if (Code::isError (result)) {
+                std::string errmsg {errstr ? errstr : sqlite3_errstr (result)};
+                sqlite3_free (errstr);
+
+                throw QueryError {errmsg};
+            }
+
+            active_ = false;
+        }
+    }
+
+    /**
+     * The number of columns this statement returns.
+     * @return the number of result columns, 0 for statements without a result
+     */
+    std::size_t Statement::columns () const
+    {
+        return static_cast<std::size_t> (sqlite3_column_count (stmt_));
+    }
+
+    /**
+     * The number of parameters this statement takes.
+     * @return the largest parameter index, 0 for statements without parameters
+     */
+    std::size_t Statement::parameters () const
+    {
+        return static_cast<std::size_t> (sqlite3_bind_parameter_count (stmt_));
+    }
+
+    /**
+     * Whether this statement leaves the database unchanged when executed.
+     * @return true iff executing this statement does not write to the database
+     */
+    bool Statement::readOnly () const { return sqlite3_stmt_readonly (stmt_) != 0; }
+
+    /**
+     * What the executions of this statement cost so far.
+     * The executions, steps and time are only measured while the database collects
+     * metrics, otherwise only the counters of sqlite are available.
+     * @return the metrics of this statement
+     * @see Database::collectMetrics
+     */
+    StatementMetrics Statement::metrics () const
+    {
+        if (probe_) {
+            probe_->flush (stmt_);
+            return probe_->totals ();
+        }
+
+        auto counter = [this] (int counter) {
+            return static_cast<std::uint64_t> (sqlite3_stmt_status (stmt_, counter, 0));
+        };
+
+        StatementMetrics metrics {};
+
+        metrics.fullScanSteps = counter (SQLITE_STMTSTATUS_FULLSCAN_STEP);
+        metrics.sorts = counter (SQLITE_STMTSTATUS_SORT);
+        metrics.autoIndexes = counter (SQLITE_STMTSTATUS_AUTOINDEX);
+        metrics.vmSteps = counter (SQLITE_STMTSTATUS_VM_STEP);
+        metrics.reprepares = counter (SQLITE_STMTSTATUS_REPREPARE);
+        metrics.memoryUsed = counter (SQLITE_STMTSTATUS_MEMUSED);
+
+        return metrics;
+    }
 } // namespace cqlite
 
@@ -25,19 +25,48 @@
 #ifndef CQLITE_STATEMENT_INC
 #define CQLITE_STATEMENT_INC
 
+#include <cqlite/array.hpp>
 #include <cqlite/cqlite_export.hpp>
 #include <cqlite/datetime.hpp>
 #include <cqlite/error.hpp>
+#include <cqlite/metrics.hpp>
 #include <cqlite/result.hpp>
+#include <cqlite/rows.hpp>
+#include <cqlite/view.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 struct sqlite3_stmt;
 
 namespace cqlite {
 
+    class ContentionPolicy;
+    class Database;
+    class StatementCache;
+
+    template <typename, typename>
+    class TypedStatement;
+
+    namespace detail {
+
+        template <typename Row, typename = void>
+        struct IsTupleLike : std::false_type
+        {};
+
+        template <typename Row>
+        struct IsTupleLike<Row, std::void_t<decltype (std::tuple_size<Row>::value)>> :
+            std::true_type
+        {};
+    } // namespace detail
+
     class CQLITE_EXPORT StatementError : public Error
     {
         using Base = Error;
@@ -68,16 +97,222 @@ namespace cqlite {
         Statement& operator<< (std::int64_t);
         Statement& operator<< (std::nullptr_t);
         Statement& operator<< (const std::string&);
+        Statement& operator<< (std::string_view);
+        Statement& operator<< (const char*);
+        Statement& operator<< (BlobView);
+        Statement& operator<< (Borrowed<std::string_view>);
+        Statement& operator<< (Borrowed<BlobView>);
         Statement& operator<< (const DateTime&);
+        Statement& operator<< (const ArrayView&);
+        Statement& operator<< (ZeroBlob);
+
+        Statement& bind (int, const std::tuple<const void*, std::size_t>&);
+        Statement& bind (int, double);
+        Statement& bind (int, int);
+        Statement& bind (int, std::size_t);
+        Statement& bind (int, std::int64_t);
+        Statement& bind (int, std::nullptr_t);
+        Statement& bind (int, const std::string&);
+        Statement& bind (int, std::string_view);
+        Statement& bind (int, const char*);
+        Statement& bind (int, BlobView);
+        Statement& bind (int, Borrowed<std::string_view>);
+        Statement& bind (int, Borrowed<BlobView>);
+        Statement& bind (int, const DateTime&);
+        Statement& bind (int, const ArrayView&);
+        Statement& bind (int, ZeroBlob);
+
+        template <typename Value>
+        Statement& bind (std::string_view, const Value&);
 
+        int parameter (std::string_view);
+
+        Statement& clearBindings ();
         Statement& reset ();
 
         Result execute ();
 
+        template <typename... Columns>
+        Rows<Columns...> rows ();
+
+        template <typename Range>
+        std::size_t executeMany (const Range&, std::size_t = 0);
+
+        std::size_t columns () const;
+        std::size_t parameters () const;
+        bool readOnly () const;
+
+        StatementMetrics metrics () const;
+
+      private:
+        /**
+         * The transaction and the bookkeeping of one executeMany run.
+         */
+        class CQLITE_EXPORT Batch
+        {
+          public:
+            Batch (sqlite3_stmt*, ContentionPolicy*, StatementProbe*, std::size_t);
+            ~Batch ();
+
+            Batch (const Batch&) = delete;
+            Batch& operator= (const Batch&) = delete;
+
+            void step ();
+            std::size_t finish ();
+
+          private:
+            void begin ();
+            void commit ();
+
+          private:
+            sqlite3_stmt* stmt_;
+            ContentionPolicy* contention_;
+            StatementProbe* probe_;
+            std::size_t commitEvery_;
+            std::size_t pending_;
+            std::size_t changes_;
+            bool owned_;
+            bool active_;
+        };
+
+      private:
+        friend class Database;
+        Statement (sqlite3_stmt*, std::weak_ptr<StatementCache>);
+
+        template <typename, typename>
+        friend class TypedStatement;
+
+        template <typename Row>
+        void bindRow (const Row&);
+
+        void release ();
+
       private:
         sqlite3_stmt* stmt_;
         int index_;
+
+        /** The indices of the named parameters looked up so far */
+        std::vector<std::pair<std::string, int>> parameters_;
+        std::weak_ptr<StatementCache> cache_;
+        std::shared_ptr<ContentionPolicy> contention_;
+        std::shared_ptr<StatementProbe> probe_;
     };
+
+    /**
+     * Executes this statement once for every row of the given range.
+     * Every row is bound starting with the first parameter of this statement, like
+     * after reset, parameters a row does not bind keep the values bound before. Tuple
+     * like rows (std::tuple, std::pair, std::array) are bound element by element, any
+     * other row is bound with an `operator<<` on this statement, which can be provided
+     * for own types, e.g.
+     * @code
+
+     Statement& operator<< (Statement& statement, const Thing& thing)
+     {
+        return statement << thing.name << thing.age << thing.role;
+     }
+
+     std::vector<Thing> things;
+     cqlite::Statement insert = db.prepare (
+         "INSERT INTO things (name, age, role) VALUES (?1, ?2, ?3)");
+
+     insert.executeMany (things, 1000);
+
+     @endcode
+     * If the connection is not already within a transaction, the run is wrapped into
+     * one (BEGIN IMMEDIATE) that is committed every given number of rows and at the end.
+     * If a row fails, the open transaction is rolled back, rows committed before stay.
+     * @param rows the rows to insert
+     * @param commitEvery the number of rows after which the transaction is committed
+     * and a new one begins, 0 commits only once at the end
+     * @return the total number of rows changed
+     * @throws StatementError if a row cannot be bound
+     * @throws QueryError if a row cannot be executed
+     */
+    template <typename Range>
+    inline std::size_t Statement::executeMany (const Range& rows, std::size_t commitEvery)
+    {
+        Batch batch {stmt_, contention_.get (), probe_.get (), commitEvery};
+
+        for (const auto& row : rows) {
+            reset ();
+            bindRow (row);
+            batch.step ();
+        }
+
+        return batch.finish ();
+    }
+
+    /**
+     * Executes this statement and returns its rows as a range of tuples of the given
+     * column types, e.g.
+     * @code
+
+     cqlite::Statement select = db.prepare ("SELECT id, name, weight FROM things");
+
+     for (auto [id, name, weight] : select.rows<std::int64_t, std::string, double> ()) {
+         ...
+     }
+
+     @endcode
+     * The number of columns is checked once before the statement is executed.
+     * @return the rows of the result
+     * @throws StatementError if the statement has a different number of columns
+     * @throws QueryError if the statement cannot be executed
+     * @see Rows
+     */
+    template <typename... Columns>
+    inline Rows<Columns...> Statement::rows ()
+    {
+        if (columns () != sizeof...(Columns)) {
+            throw StatementError {"The statement has " + std::to_string (columns ())
+                + " columns but " + std::to_string (sizeof...(Columns))
+                + " are to be read"};
+        }
+
+        return Rows<Columns...> {execute ()};
+    }
+
+    /**
+     * Binds a value to the parameter with the given name, e.g.
+     * @code
+
+     cqlite::Statement update = db.prepare (
+         "UPDATE things SET age = :age WHERE role = :role");
+
+     update.bind (":role", "admin");
+
+     for (int age : ages) {
+         update.reset ();
+         update.bind (":age", age);
+         update.execute ();
+     }
+
+     @endcode
+     * Any value that can be streamed to a statement can be bound by name.
+     * @param name the name of the parameter including its prefix
+     * @param value the value to bind
+     * @return this statement
+     * @throws StatementError if there is no such parameter or the value cannot be bound
+     * @see parameter
+     */
+    template <typename Value>
+    inline Statement& Statement::bind (std::string_view name, const Value& value)
+    {
+        return bind (parameter (name), value);
+    }
+
+    template <typename Row>
+    inline void Statement::bindRow (const Row& row)
+    {
+        if constexpr (detail::IsTupleLike<Row>::value) {
+            std::apply (
+                [this] (const auto&... values) { (*this << ... << values); }, row);
+        }
+        else {
+            *this << row;
+        }
+    }
 } // namespace cqlite
 
 #endif /* CQLITE_STATEMENT_INC */
@@ -0,0 +1,558 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * table.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_TABLE_INC
+#define CQLITE_TABLE_INC
+
+#include <cqlite/functions.hpp>
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cqlite {
+
+    /**
+     * A column of a virtual table over a container, its name and how it is read from an
+     * element of the container.
+     * @tparam Accessor a pointer to a member or a callable taking an element
+     * @tparam Key whether the table is looked up by this column
+     * @see column
+     * @see key
+     */
+    template <typename Accessor, bool Key>
+    struct TableColumn
+    {
+        std::string name;
+        Accessor accessor;
+    };
+
+    /**
+     * A column of a virtual table.
+     * @param name the name of the column in sql
+     * @param accessor a pointer to a member or a callable taking an element
+     * @return the column
+     */
+    template <typename Accessor>
+    inline TableColumn<std::decay_t<Accessor>, false> column (
+        std::string name, Accessor&& accessor)
+    {
+        return {std::move (name), std::forward<Accessor> (accessor)};
+    }
+
+    /**
+     * The key column of a virtual table, equality constraints on it are looked up with a
+     * hash index instead of scanning the container.
+     * @param name the name of the column in sql
+     * @param accessor a pointer to a member or a callable taking an element
+     * @return the column
+     */
+    template <typename Accessor>
+    inline TableColumn<std::decay_t<Accessor>, true> key (
+        std::string name, Accessor&& accessor)
+    {
+        return {std::move (name), std::forward<Accessor> (accessor)};
+    }
+
+    namespace detail {
+
+        /**
+         * The module and the user data of a virtual table, as they are registered with
+         * sqlite3_create_module_v2.
+         */
+        struct ModuleDefinition
+        {
+            const sqlite3_module* module;
+            void* data;
+            void (*destroy) (void*);
+        };
+
+        template <typename>
+        struct IsKey : std::false_type
+        {};
+
+        template <typename Accessor>
+        struct IsKey<TableColumn<Accessor, true>> : std::true_type
+        {};
+
+        /** The position of the key column among the columns, -1 if there is none. */
+        template <typename... Columns>
+        constexpr int keyColumn ()
+        {
+            constexpr bool keys[] = {IsKey<Columns>::value..., false};
+
+            for (std::size_t i = 0; i < sizeof...(Columns); ++i) {
+                if (keys[i]) {
+                    return static_cast<int> (i);
+                }
+            }
+
+            return -1;
+        }
+
+        template <typename Row, int Key, typename Columns>
+        struct KeyOf
+        {
+            using type = std::int64_t;
+        };
+
+        template <typename Row, int Key, typename... Columns>
+        struct KeyOf<Row, Key, std::tuple<Columns...>>
+        {
+            using Column = std::tuple_element_t<Key, std::tuple<Columns...>>;
+            using type = std::decay_t<std::invoke_result_t<
+                const decltype (Column::accessor)&, const Row&>>;
+        };
+
+        template <typename Row, typename... Columns>
+        struct KeyOf<Row, -1, std::tuple<Columns...>>
+        {
+            using type = std::int64_t;
+        };
+
+        /**
+         * A read-only, eponymous virtual table over a random access range, which is
+         * referred to and not copied.
+         */
+        template <typename Range, typename... Columns>
+        class ContainerTable
+        {
+          public:
+            using Iterator = decltype (std::begin (std::declval<const Range&> ()));
+            using Row = std::decay_t<decltype (*std::declval<Iterator> ())>;
+
+            static constexpr int Key = keyColumn<Columns...> ();
+            using KeyType = typename KeyOf<Row, Key, std::tuple<Columns...>>::type;
+
+            using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+            static_assert (std::is_base_of_v<std::random_access_iterator_tag, Category>,
+                "A virtual table needs a random access range");
+            static_assert ((0 + ... + static_cast<int> (IsKey<Columns>::value)) <= 1,
+                "A virtual table has at most one key column");
+
+          public:
+            ContainerTable (const Range&, Columns...);
+
+            static ModuleDefinition define (const Range&, Columns...);
+
+          private:
+            /** The plans chosen by xBestIndex, passed as idxNum to xFilter. */
+            enum Plan
+            {
+                Scan,
+                ByRowid,
+                ByKey
+            };
+
+            struct Table : sqlite3_vtab
+            {
+                ContainerTable* owner;
+            };
+
+            struct Cursor : sqlite3_vtab_cursor
+            {
+                std::vector<std::size_t> matches;
+                std::size_t at;
+                bool scan;
+            };
+
+          private:
+            std::size_t size () const;
+            const Row& row (std::size_t) const;
+            std::string schema () const;
+
+            void index ();
+
+            template <std::size_t... Index>
+            void result (
+                sqlite3_context*, const Row&, int, std::index_sequence<Index...>);
+
+            static int connect (sqlite3*, void*, int, const char* const*, sqlite3_vtab**,
+                char**);
+            static int bestIndex (sqlite3_vtab*, sqlite3_index_info*);
+            static int disconnect (sqlite3_vtab*);
+            static int open (sqlite3_vtab*, sqlite3_vtab_cursor**);
+            static int close (sqlite3_vtab_cursor*);
+            static int filter (
+                sqlite3_vtab_cursor*, int, const char*, int, sqlite3_value**);
+            static int next (sqlite3_vtab_cursor*);
+            static int eof (sqlite3_vtab_cursor*);
+            static int column (sqlite3_vtab_cursor*, sqlite3_context*, int);
+            static int rowid (sqlite3_vtab_cursor*, sqlite3_int64*);
+
+            static const sqlite3_module Module;
+
+          private:
+            const Range* rows_;
+            std::tuple<Columns...> columns_;
+
+            /** The positions of the rows by key, built on the first lookup */
+            std::unordered_multimap<KeyType, std::size_t> keys_;
+            bool indexed_;
+        };
+
+        template <typename Range, typename... Columns>
+        inline ContainerTable<Range, Columns...>::ContainerTable (
+            const Range& rows, Columns... columns) :
+            rows_ {&rows}, columns_ {std::move (columns)...}, keys_ {}, indexed_ {false}
+        {}
+
+        /**
+         * The definition of a virtual table over the given rows.
+         * The table is moved to the heap and owned by sqlite from now on.
+         */
+        template <typename Range, typename... Columns>
+        inline ModuleDefinition ContainerTable<Range, Columns...>::define (
+            const Range& rows, Columns... columns)
+        {
+            return ModuleDefinition {&Module,
+                new ContainerTable {rows, std::move (columns)...},
+                &detail::destroy<ContainerTable>};
+        }
+
+        template <typename Range, typename... Columns>
+        inline std::size_t ContainerTable<Range, Columns...>::size () const
+        {
+            return static_cast<std::size_t> (std::size (*rows_));
+        }
+
+        template <typename Range, typename... Columns>
+        inline const typename ContainerTable<Range, Columns...>::Row&
+            ContainerTable<Range, Columns...>::row (std::size_t position) const
+        {
+            return std::begin (*rows_)[static_cast<std::ptrdiff_t> (position)];
+        }
+
+        template <typename Range, typename... Columns>
+        inline std::string ContainerTable<Range, Columns...>::schema () const
+        {
+            std::string sql {"CREATE TABLE x ("};
+            bool first = true;
+
+            std::apply (
+                [&] (const auto&... columns) {
+                    auto add = [&] (const std::string& name) {
+                        sql += first ? "\"" : ", \"";
+                        first = false;
+
+                        for (char c : name) {
+                            sql += c == '"' ? std::string {"\"\""} : std::string {c};
+                        }
+
+                        sql += '"';
+                    };
+
+                    (add (columns.name), ...);
+                },
+                columns_);
+
+            return sql + ")";
+        }
+
+        template <typename Range, typename... Columns>
+        inline void ContainerTable<Range, Columns...>::index ()
+        {
+            if constexpr (Key >= 0) {
+                if (! indexed_) {
+                    const auto& accessor = std::get<Key> (columns_).accessor;
+                    keys_.reserve (size ());
+
+                    for (std::size_t i = 0; i < size (); ++i) {
+                        keys_.emplace (std::invoke (accessor, row (i)), i);
+                    }
+
+                    indexed_ = true;
+                }
+            }
+        }
+
+        template <typename Range, typename... Columns>
+        template <std::size_t... Index>
+        inline void ContainerTable<Range, Columns...>::result (sqlite3_context* context,
+            const Row& row, int column, std::index_sequence<Index...>)
+        {
+            auto set = [context, &row] (const auto& accessor) {
+                decltype (auto) value = std::invoke (accessor, row);
+                using Value = decltype (value);
+
+                // Text that lives within the container is handed out without a copy.
+                if constexpr (std::is_lvalue_reference_v<Value>
+                    && std::is_same_v<std::decay_t<Value>, std::string>) {
+                    sqlite3_result_text64 (context, value.data (), value.size (),
+                        SQLITE_STATIC, SQLITE_UTF8);
+                }
+                else {
+                    setResult (context, value);
+                }
+            };
+
+            ((column == static_cast<int> (Index)
+                     ? (set (std::get<Index> (columns_).accessor), true)
+                     : false)
+                || ...);
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::connect (sqlite3* db, void* data,
+            int, const char* const*, sqlite3_vtab** vtab, char**)
+        {
+            auto* owner = static_cast<ContainerTable*> (data);
+
+            try {
+                int result = sqlite3_declare_vtab (db, owner->schema ().c_str ());
+
+                if (result != SQLITE_OK) {
+                    return result;
+                }
+            }
+            catch (const std::bad_alloc&) {
+                return SQLITE_NOMEM;
+            }
+
+            Table* table = new (std::nothrow) Table {};
+
+            if (! table) {
+                return SQLITE_NOMEM;
+            }
+
+            table->owner = owner;
+            *vtab = table;
+
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::bestIndex (
+            sqlite3_vtab* vtab, sqlite3_index_info* info)
+        {
+            const ContainerTable& owner = *static_cast<Table*> (vtab)->owner;
+            int plan = Scan;
+            int constraint = -1;
+
+            for (int i = 0; i < info->nConstraint; ++i) {
+                const auto& candidate = info->aConstraint[i];
+
+                if (! candidate.usable || candidate.op != SQLITE_INDEX_CONSTRAINT_EQ) {
+                    continue;
+                }
+
+                if (candidate.iColumn == -1) {
+                    plan = ByRowid;
+                    constraint = i;
+                    break;
+                }
+
+                // The keys are hashed as they are, other collations need a scan.
+                const char* const collation = sqlite3_vtab_collation (info, i);
+
+                if (Key >= 0 && candidate.iColumn == Key && collation
+                    && sqlite3_stricmp (collation, "BINARY") == 0) {
+                    plan = ByKey;
+                    constraint = i;
+                }
+            }
+
+            info->idxNum = plan;
+
+            if (constraint >= 0) {
+                // sqlite checks the value again, e.g. for a real compared to a key.
+                info->aConstraintUsage[constraint].argvIndex = 1;
+                info->aConstraintUsage[constraint].omit = 0;
+            }
+
+            switch (plan) {
+                case ByRowid:
+                    info->estimatedCost = 1;
+                    info->estimatedRows = 1;
+                    info->idxFlags = SQLITE_INDEX_SCAN_UNIQUE;
+                    break;
+                case ByKey:
+                    info->estimatedCost = 10;
+                    info->estimatedRows = 10;
+                    break;
+                default:
+                    info->estimatedCost = static_cast<double> (owner.size ()) + 1;
+                    info->estimatedRows = static_cast<sqlite3_int64> (owner.size ());
+                    break;
+            }
+
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::disconnect (sqlite3_vtab* vtab)
+        {
+            delete static_cast<Table*> (vtab);
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::open (
+            sqlite3_vtab*, sqlite3_vtab_cursor** cursor)
+        {
+            *cursor = new (std::nothrow) Cursor {};
+
+            return *cursor ? SQLITE_OK : SQLITE_NOMEM;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::close (sqlite3_vtab_cursor* cursor)
+        {
+            delete static_cast<Cursor*> (cursor);
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::filter (sqlite3_vtab_cursor* base,
+            int plan, const char*, int, sqlite3_value** values)
+        {
+            Cursor& cursor = *static_cast<Cursor*> (base);
+            ContainerTable& owner = *static_cast<Table*> (base->pVtab)->owner;
+
+            cursor.matches.clear ();
+            cursor.at = 0;
+            cursor.scan = plan == Scan;
+
+            try {
+                if (plan == ByRowid) {
+                    const sqlite3_int64 rowid = sqlite3_value_int64 (values[0]);
+
+                    if (sqlite3_value_type (values[0]) != SQLITE_NULL && rowid >= 0
+                        && static_cast<std::size_t> (rowid) < owner.size ()) {
+                        cursor.matches.push_back (static_cast<std::size_t> (rowid));
+                    }
+                }
+                else if constexpr (Key >= 0) {
+                    if (plan == ByKey && sqlite3_value_type (values[0]) != SQLITE_NULL) {
+                        KeyType key {};
+                        readArgument (values[0], key);
+
+                        owner.index ();
+                        auto [first, last] = owner.keys_.equal_range (key);
+
+                        for (; first != last; ++first) {
+                            cursor.matches.push_back (first->second);
+                        }
+
+                        std::sort (cursor.matches.begin (), cursor.matches.end ());
+                    }
+                }
+            }
+            catch (const std::bad_alloc&) {
+                return SQLITE_NOMEM;
+            }
+
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::next (sqlite3_vtab_cursor* cursor)
+        {
+            ++static_cast<Cursor*> (cursor)->at;
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::eof (sqlite3_vtab_cursor* base)
+        {
+            const Cursor& cursor = *static_cast<Cursor*> (base);
+            const ContainerTable& owner = *static_cast<Table*> (base->pVtab)->owner;
+
+            return cursor.at >= (cursor.scan ? owner.size () : cursor.matches.size ());
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::column (
+            sqlite3_vtab_cursor* base, sqlite3_context* context, int column)
+        {
+            const Cursor& cursor = *static_cast<Cursor*> (base);
+            ContainerTable& owner = *static_cast<Table*> (base->pVtab)->owner;
+            const std::size_t position
+                = cursor.scan ? cursor.at : cursor.matches[cursor.at];
+
+            guard (context, [&] {
+                owner.result (context, owner.row (position), column,
+                    std::index_sequence_for<Columns...> {});
+            });
+
+            return SQLITE_OK;
+        }
+
+        template <typename Range, typename... Columns>
+        inline int ContainerTable<Range, Columns...>::rowid (
+            sqlite3_vtab_cursor* base, sqlite3_int64* rowid)
+        {
+            const Cursor& cursor = *static_cast<Cursor*> (base);
+
+            *rowid = static_cast<sqlite3_int64> (
+                cursor.scan ? cursor.at : cursor.matches[cursor.at]);
+
+            return SQLITE_OK;
+        }
+
+        /** An eponymous-only module, the table exists as soon as the module does. */
+        template <typename Range, typename... Columns>
+        const sqlite3_module ContainerTable<Range, Columns...>::Module = {
+            0,           // iVersion
+            nullptr,     // xCreate
+            &connect,    // xConnect
+            &bestIndex,  // xBestIndex
+            &disconnect, // xDisconnect
+            &disconnect, // xDestroy
+            &open,       // xOpen
+            &close,      // xClose
+            &filter,     // xFilter
+            &next,       // xNext
+            &eof,        // xEof
+            &column,     // xColumn
+            &rowid,      // xRowid
+            nullptr,     // xUpdate
+            nullptr,     // xBegin
+            nullptr,     // xSync
+            nullptr,     // xCommit
+            nullptr,     // xRollback
+            nullptr,     // xFindFunction
+            nullptr,     // xRename
+            nullptr,     // xSavepoint
+            nullptr,     // xRelease
+            nullptr,     // xRollbackTo
+            nullptr      // xShadowName
+        };
+    } // namespace detail
+} // namespace cqlite
+
+#endif /* CQLITE_TABLE_INC */
@@ -0,0 +1,139 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * transaction.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/transaction.hpp>
+
+namespace cqlite {
+
+    /**
+     * Begins a transaction on the given database.
+     * @param db the database, it must outlive this transaction
+     * @param type when the transaction acquires its locks
+     * @throws QueryError if the transaction cannot be begun
+     */
+    Transaction::Transaction (Database& db, Type type) : db_ {db}, active_ {false}
+    {
+        switch (type) {
+            case Type::Deferred:
+                db_.control (Database::BeginDeferred);
+                break;
+            case Type::Immediate:
+                db_.control (Database::BeginImmediate);
+                break;
+            case Type::Exclusive:
+                db_.control (Database::BeginExclusive);
+                break;
+        }
+
+        active_ = true;
+    }
+
+    /**
+     * Rolls back the transaction if it is still active.
+     */
+    Transaction::~Transaction ()
+    {
+        if (active_) {
+            try {
+                rollback ();
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    /**
+     * Commits the transaction.
+     * If committing fails (e.g. because the database is busy) the transaction remains
+     * active, so that committing can be retried.
+     * @throws QueryError if the transaction cannot be committed
+     */
+    void Transaction::commit ()
+    {
+        if (active_) {
+            db_.control (Database::Commit);
+            active_ = false;
+        }
+    }
+
+    /**
+     * Rolls back the transaction.
+     * @throws QueryError if the transaction cannot be rolled back
+     */
+    void Transaction::rollback ()
+    {
+        if (active_) {
+            active_ = false;
+            db_.control (Database::Rollback);
+        }
+    }
+
+    /**
+     * Opens a savepoint on the given database.
+     * @param db the database, it must outlive this savepoint
+     * @throws QueryError if the savepoint cannot be opened
+     */
+    Savepoint::Savepoint (Database& db) : db_ {db}, mark_ {db_.savepoint ()} {}
+
+    /**
+     * Rolls back to the savepoint if it is still active.
+     */
+    Savepoint::~Savepoint ()
+    {
+        if (mark_.depth != 0) {
+            try {
+                rollback ();
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    /**
+     * Releases the savepoint, keeping its changes as part of the enclosing
+     * transaction, or committing them if there is none.
+     * @throws QueryError if the savepoint cannot be released
+     */
+    void Savepoint::release ()
+    {
+        if (mark_.depth != 0) {
+            db_.releaseSavepoint (mark_, false);
+            mark_.depth = 0;
+        }
+    }
+
+    /**
+     * Undoes all changes since the savepoint was opened and releases it.
+     * @throws QueryError if the savepoint cannot be rolled back to
+     */
+    void Savepoint::rollback ()
+    {
+        if (mark_.depth != 0) {
+            const Database::SavepointMark mark = mark_;
+            mark_.depth = 0;
+
+            db_.releaseSavepoint (mark, true);
+        }
+    }
+} // namespace cqlite
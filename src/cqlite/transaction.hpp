@@ -0,0 +1,115 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * transaction.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_TRANSACTION_INC
+#define CQLITE_TRANSACTION_INC
+
+#include <cqlite/cqlite_export.hpp>
+#include <cqlite/database.hpp>
+
+#include <cstddef>
+
+namespace cqlite {
+
+    /**
+     * A transaction that is rolled back unless it is committed before it goes out of
+     * scope.
+     */
+    class CQLITE_EXPORT Transaction
+    {
+      public:
+        /**
+         * When the transaction acquires its locks.
+         */
+        enum class Type
+        {
+            /** On first access, reading first and writing later on. */
+            Deferred,
+            /** Immediately for writing, other writers fail or wait right at the start,
+             * instead of a deadlock when a reader attempts to write later on. */
+            Immediate,
+            /** Immediately for writing, in rollback journal modes readers are locked
+             * out as well. */
+            Exclusive
+        };
+
+      public:
+        explicit Transaction (Database&, Type = Type::Deferred);
+        ~Transaction ();
+
+        Transaction (const Transaction&) = delete;
+        Transaction& operator= (const Transaction&) = delete;
+
+        void commit ();
+        void rollback ();
+
+        bool active () const;
+
+      private:
+        Database& db_;
+        bool active_;
+    };
+
+    /**
+     * A savepoint that is rolled back unless it is released before it goes out of
+     * scope.
+     *
+     * Savepoints nest, within a transaction or on their own. Releasing or rolling back
+     * a savepoint, or ending its transaction, ends all savepoints nested within it as
+     * well, their guards become inactive and do nothing anymore.
+     */
+    class CQLITE_EXPORT Savepoint
+    {
+      public:
+        explicit Savepoint (Database&);
+        ~Savepoint ();
+
+        Savepoint (const Savepoint&) = delete;
+        Savepoint& operator= (const Savepoint&) = delete;
+
+        void release ();
+        void rollback ();
+
+        bool active () const;
+
+      private:
+        Database& db_;
+        Database::SavepointMark mark_;
+    };
+
+    /**
+     * Whether this transaction is neither committed nor rolled back.
+     * @return true iff the transaction is still open
+     */
+    inline bool Transaction::active () const { return active_; }
+
+    /**
+     * Whether this savepoint is neither released nor rolled back, also not by ending a
+     * savepoint or transaction it is nested within.
+     * @return true iff the savepoint is still open
+     */
+    inline bool Savepoint::active () const { return db_.holds (mark_); }
+} // namespace cqlite
+
+#endif /* CQLITE_TRANSACTION_INC */
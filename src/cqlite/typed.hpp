@@ -0,0 +1,288 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * typed.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_TYPED_INC
+#define CQLITE_TYPED_INC
+
+#include <cqlite/array.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/datetime.hpp>
+#include <cqlite/rows.hpp>
+#include <cqlite/statement.hpp>
+#include <cqlite/view.hpp>
+
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace cqlite {
+
+    /** The parameter types of a TypedStatement. */
+    template <typename... Types>
+    struct Params
+    {};
+
+    /** The column types of a TypedStatement. */
+    template <typename... Types>
+    struct Columns
+    {};
+
+    namespace detail {
+
+        template <typename T>
+        inline int bindParameter (sqlite3_stmt*, int, const T&)
+        {
+            static_assert (AlwaysFalse<T>, "There is no parameter binder for this type");
+            return SQLITE_MISUSE;
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, int value)
+        {
+            return sqlite3_bind_int (stmt, index, value);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, bool value)
+        {
+            return sqlite3_bind_int (stmt, index, value ? 1 : 0);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, std::int64_t value)
+        {
+            return sqlite3_bind_int64 (stmt, index, value);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, std::size_t value)
+        {
+            return sqlite3_bind_int64 (stmt, index, static_cast<std::int64_t> (value));
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, double value)
+        {
+            return sqlite3_bind_double (stmt, index, value);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, std::nullptr_t)
+        {
+            return sqlite3_bind_null (stmt, index);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, const DateTime& value)
+        {
+            return sqlite3_bind_int64 (stmt, index, value.time_since_epoch ().count ());
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, std::string_view value)
+        {
+            // An empty view may not point anywhere, which would be bound as null.
+            return sqlite3_bind_text64 (stmt, index, value.data () ? value.data () : "",
+                value.size (), SQLITE_TRANSIENT, SQLITE_UTF8);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, const std::string& value)
+        {
+            return bindParameter (stmt, index, std::string_view {value});
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, const char* value)
+        {
+            return value ? bindParameter (stmt, index, std::string_view {value})
+                         : sqlite3_bind_null (stmt, index);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, BlobView value)
+        {
+            // An empty view may not point anywhere, which would be bound as null.
+            return sqlite3_bind_blob64 (stmt, index, value.data () ? value.data () : "",
+                value.size (), SQLITE_TRANSIENT);
+        }
+
+        inline int bindParameter (
+            sqlite3_stmt* stmt, int index, Borrowed<std::string_view> value)
+        {
+            return sqlite3_bind_text64 (stmt, index,
+                value.view.data () ? value.view.data () : "", value.view.size (),
+                SQLITE_STATIC, SQLITE_UTF8);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, Borrowed<BlobView> value)
+        {
+            return sqlite3_bind_blob64 (stmt, index,
+                value.view.data () ? value.view.data () : "", value.view.size (),
+                SQLITE_STATIC);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, ZeroBlob value)
+        {
+            return sqlite3_bind_zeroblob64 (stmt, index, value.size);
+        }
+
+        inline int bindParameter (sqlite3_stmt* stmt, int index, const ArrayView& value)
+        {
+            return bindArray (stmt, index, value);
+        }
+
+        template <typename T>
+        inline int bindParameter (
+            sqlite3_stmt* stmt, int index, const std::optional<T>& value)
+        {
+            return value ? bindParameter (stmt, index, *value)
+                         : sqlite3_bind_null (stmt, index);
+        }
+    } // namespace detail
+
+    template <typename, typename>
+    class TypedStatement;
+
+    /**
+     * A statement with parameter and column types that are fixed at compile time, e.g.
+     * @code
+
+     cqlite::TypedStatement<cqlite::Params<std::string_view>,
+         cqlite::Columns<std::int64_t, std::string>>
+         select {db, "SELECT id, name FROM authors WHERE name LIKE ?1"};
+
+     for (auto [id, name] : select ("Aldous%")) {
+         ...
+     }
+
+     @endcode
+     * The numbers of parameters and columns are checked once when the statement is
+     * prepared. A call binds all the parameters in one sequence, whose result is
+     * checked once, and executes the statement.
+     */
+    template <typename... Parameters, typename... Results>
+    class TypedStatement<Params<Parameters...>, Columns<Results...>>
+    {
+      public:
+        TypedStatement (Database&, const std::string&);
+        explicit TypedStatement (Statement&&);
+
+        Rows<Results...> operator() (const Parameters&...);
+
+        Statement& statement ();
+
+      private:
+        template <std::size_t... Index>
+        int bind (std::index_sequence<Index...>, const Parameters&...);
+
+      private:
+        Statement statement_;
+    };
+
+    /**
+     * Prepares the given sql on the given database.
+     * @param db the database
+     * @param sql the sql text of the statement
+     * @throws QueryError if the statement cannot be prepared
+     * @throws StatementError if the statement has other numbers of parameters or columns
+     */
+    template <typename... Parameters, typename... Results>
+    inline TypedStatement<Params<Parameters...>, Columns<Results...>>::TypedStatement (
+        Database& db, const std::string& sql) :
+        TypedStatement {db.prepare (sql)}
+    {}
+
+    /**
+     * Takes over the given statement.
+     * @param statement the statement
+     * @throws StatementError if the statement has other numbers of parameters or columns
+     */
+    template <typename... Parameters, typename... Results>
+    inline TypedStatement<Params<Parameters...>, Columns<Results...>>::TypedStatement (
+        Statement&& statement) :
+        statement_ {std::move (statement)}
+    {
+        if (statement_.parameters () != sizeof...(Parameters)) {
+            throw StatementError {"The statement has "
+                + std::to_string (statement_.parameters ()) + " parameters but "
+                + std::to_string (sizeof...(Parameters)) + " are to be bound"};
+        }
+
+        if (statement_.columns () != sizeof...(Results)) {
+            throw StatementError {"The statement has "
+                + std::to_string (statement_.columns ()) + " columns but "
+                + std::to_string (sizeof...(Results)) + " are to be read"};
+        }
+    }
+
+    /**
+     * Binds the given parameters and executes the statement.
+     * The rows of a previous call must not be used anymore.
+     * @param parameters the values of all the parameters, in order
+     * @return the rows of the result
+     * @throws StatementError if a parameter cannot be bound
+     * @throws QueryError if the statement cannot be executed
+     */
+    template <typename... Parameters, typename... Results>
+    inline Rows<Results...>
+        TypedStatement<Params<Parameters...>, Columns<Results...>>::operator() (
+            const Parameters&... parameters)
+    {
+        statement_.reset ();
+
+        const int result
+            = bind (std::index_sequence_for<Parameters...> {}, parameters...);
+
+        if (result != SQLITE_OK) {
+            throw StatementError {sqlite3_errstr (result)};
+        }
+
+        return Rows<Results...> {statement_.execute ()};
+    }
+
+    /**
+     * The underlying statement.
+     * @return the statement
+     */
+    template <typename... Parameters, typename... Results>
+    inline Statement&
+        TypedStatement<Params<Parameters...>, Columns<Results...>>::statement ()
+    {
+        return statement_;
+    }
+
+    template <typename... Parameters, typename... Results>
+    template <std::size_t... Index>
+    inline int TypedStatement<Params<Parameters...>, Columns<Results...>>::bind (
+        std::index_sequence<Index...>, [[maybe_unused]] const Parameters&... parameters)
+    {
+        [[maybe_unused]] sqlite3_stmt* const stmt = statement_.stmt_;
+        int result = SQLITE_OK;
+
+        // Stops binding at the first failure, which is then reported once.
+        ((result = result == SQLITE_OK
+                 ? detail::bindParameter (stmt, static_cast<int> (Index) + 1, parameters)
+                 : result),
+            ...);
+
+        return result;
+    }
+} // namespace cqlite
+
+#endif /* CQLITE_TYPED_INC */
@@ -0,0 +1,165 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * view.hpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#ifndef CQLITE_VIEW_INC
+#define CQLITE_VIEW_INC
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cqlite {
+
+    namespace detail {
+
+        template <typename Container, typename = void>
+        struct IsContiguous : std::false_type
+        {};
+
+        template <typename Container>
+        struct IsContiguous<Container,
+            std::void_t<decltype (std::data (std::declval<const Container&> ())),
+                decltype (std::size (std::declval<const Container&> ()))>> :
+            std::is_trivially_copyable<std::remove_cv_t<std::remove_pointer_t<
+                decltype (std::data (std::declval<const Container&> ()))>>>
+        {};
+
+        template <typename Container>
+        constexpr bool IsBlobSource = IsContiguous<Container>::value
+            && ! std::is_convertible_v<const Container&, std::string_view>;
+    } // namespace detail
+
+    /**
+     * A non-owning view of binary data, the blob counterpart of std::string_view.
+     *
+     * It can be created from any contiguous container of trivially copyable values
+     * (std::vector, std::array, C arrays, ...), text like containers are excluded in
+     * order to keep them bound as text.
+     */
+    class BlobView
+    {
+      public:
+        constexpr BlobView () noexcept;
+        constexpr BlobView (const void*, std::size_t) noexcept;
+
+        template <typename Container,
+            typename = std::enable_if_t<detail::IsBlobSource<Container>>>
+        constexpr BlobView (const Container&) noexcept;
+
+        constexpr const void* data () const noexcept;
+        constexpr std::size_t size () const noexcept;
+        constexpr bool empty () const noexcept;
+
+      private:
+        const void* data_;
+        std::size_t size_;
+    };
+
+    /**
+     * A value whose memory is guaranteed by the caller to stay valid and unchanged for
+     * as long as the statement it is bound to uses it.
+     * @see borrow
+     */
+    template <typename View>
+    struct Borrowed
+    {
+        View view;
+    };
+
+    /**
+     * A blob of the given size that consists of zeros, which sqlite stores without
+     * allocating it in memory, e.g. as a placeholder that is written with a BlobStream.
+     */
+    struct ZeroBlob
+    {
+        std::size_t size;
+    };
+
+    constexpr BlobView::BlobView () noexcept : data_ {nullptr}, size_ {0} {}
+
+    /**
+     * A view on the given memory.
+     * @param data the first byte
+     * @param size the number of bytes
+     */
+    constexpr BlobView::BlobView (const void* data, std::size_t size) noexcept :
+        data_ {data}, size_ {size}
+    {}
+
+    /**
+     * A view on the contents of the given container.
+     * @param container a contiguous container of trivially copyable values
+     */
+    template <typename Container, typename>
+    constexpr BlobView::BlobView (const Container& container) noexcept :
+        data_ {std::data (container)},
+        size_ {std::size (container) * sizeof (*std::data (container))}
+    {}
+
+    /**
+     * The viewed memory.
+     * @return the first byte
+     */
+    constexpr const void* BlobView::data () const noexcept { return data_; }
+
+    /**
+     * The size of the viewed memory.
+     * @return the number of bytes
+     */
+    constexpr std::size_t BlobView::size () const noexcept { return size_; }
+
+    /**
+     * Whether the view is empty.
+     * @return true iff the view has no bytes
+     */
+    constexpr bool BlobView::empty () const noexcept { return size_ == 0; }
+
+    /**
+     * Marks the given text as borrowed, so that it is bound without being copied.
+     * The text must stay valid until the parameter is bound again or the statement is
+     * destroyed.
+     * @param text the text
+     * @return the borrowed text
+     */
+    constexpr Borrowed<std::string_view> borrow (std::string_view text) noexcept
+    {
+        return Borrowed<std::string_view> {text};
+    }
+
+    /**
+     * Marks the given blob as borrowed, so that it is bound without being copied.
+     * The blob must stay valid until the parameter is bound again or the statement is
+     * destroyed.
+     * @param blob the blob
+     * @return the borrowed blob
+     */
+    constexpr Borrowed<BlobView> borrow (BlobView blob) noexcept
+    {
+        return Borrowed<BlobView> {blob};
+    }
+} // namespace cqlite
+
+#endif /* CQLITE_VIEW_INC */
@@ -22,14 +22,19 @@
  * This is free software, and you are welcome to redistribute it
  * under certain conditions.
  */
+#include <cqlite/columns.hpp>
 #include <cqlite/database.hpp>
+#include <cqlite/hooks.hpp>
 
 #include <gtest/gtest.h>
 
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <vector>
 
 using namespace cqlite;
 
@@ -86,6 +91,56 @@ TEST (database, hook_gets_called)
     ASSERT_EQ (watch.lastId, 10);
 }
 
+TEST (database, hooks_with_string_names_get_called)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    std::string tables;
+
+    db.addUpdateHook ("*",
+        [&tables] (Database::Operation, const std::string&, const std::string& table,
+            std::int64_t) { tables += table; });
+
+    insert (db);
+
+    ASSERT_EQ (tables.size (), 30);
+}
+
+TEST (database, update_batches_are_delivered_on_commit)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    UpdateQueue queue {4};
+    db.setUpdateBatchHook (queue.hook ());
+
+    db << "BEGIN";
+    insert (db);
+    db << "COMMIT";
+
+    db << "BEGIN";
+    insert (db);
+    db << "ROLLBACK";
+
+    db << "DELETE FROM foo WHERE id = 3";
+
+    std::vector<UpdateEvent> batch;
+
+    ASSERT_TRUE (queue.pop (batch));
+    ASSERT_EQ (batch.size (), 10);
+    ASSERT_EQ (batch.back ().operation, UpdateOperation::Insert);
+    ASSERT_EQ (batch.back ().table, "foo");
+    ASSERT_EQ (batch.back ().rowid, 10);
+
+    ASSERT_TRUE (queue.pop (batch));
+    ASSERT_EQ (batch.size (), 1);
+    ASSERT_EQ (batch.front ().operation, UpdateOperation::Delete);
+
+    ASSERT_FALSE (queue.pop (batch));
+    ASSERT_EQ (queue.dropped (), 0);
+}
+
 TEST (database, can_insert_and_retrieve_blob)
 {
     Database db {":memory:"};
@@ -119,3 +174,134 @@ TEST (database, can_insert_and_retrieve_blob)
         ASSERT_EQ (i, resultPtr[i]);
     }
 }
+
+TEST (database, views_can_be_bound_with_and_without_copying)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE foo ("
+          "id INTEGER PRIMARY KEY, "
+          "name TEXT, "
+          "data BLOB DEFAULT NULL)";
+
+    Statement insert = db.prepare ("INSERT INTO foo (name, data) VALUES (?1, ?2)");
+
+    const std::string name {"Aldous Huxley"};
+    const std::vector<std::uint32_t> data {1, 2, 3, 4};
+
+    insert << std::string_view {name}.substr (0, 6) << data;
+    insert.execute ();
+
+    insert.reset ();
+    insert << borrow (name) << borrow (data);
+    insert.execute ();
+
+    Statement select = db.prepare ("SELECT name, LENGTH (data) FROM foo ORDER BY id");
+    Result result = select.execute ();
+
+    std::string extracted;
+    std::size_t size;
+
+    result >> extracted >> size;
+
+    ASSERT_EQ (extracted, "Aldous");
+    ASSERT_EQ (size, sizeof (std::uint32_t) * data.size ());
+
+    ++result;
+    result >> extracted >> size;
+
+    ASSERT_EQ (extracted, name);
+    ASSERT_EQ (size, sizeof (std::uint32_t) * data.size ());
+}
+
+TEST (database, empty_blobs_are_not_bound_as_null)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, data BLOB)";
+
+    Statement insert = db.prepare ("INSERT INTO foo (data) VALUES (?1)");
+
+    const std::vector<unsigned char> empty {};
+
+    insert << empty;
+    insert.execute ();
+
+    insert.reset ();
+    insert << borrow (empty);
+    insert.execute ();
+
+    Statement select = db.prepare ("SELECT COUNT (*) FROM foo WHERE LENGTH (data) = 0");
+    std::size_t count;
+    select.execute () >> count;
+
+    ASSERT_EQ (count, 2);
+}
+
+TEST (database, columns_can_be_extracted_as_views)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE foo ("
+          "id INTEGER PRIMARY KEY, "
+          "name TEXT, "
+          "data BLOB DEFAULT NULL)";
+
+    const std::vector<std::uint16_t> data {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    Statement insert = db.prepare ("INSERT INTO foo (name, data) VALUES (?1, ?2)");
+    insert << "Jane" << data;
+    insert.execute ();
+
+    insert.reset ();
+    insert << nullptr << nullptr;
+    insert.execute ();
+
+    Statement select = db.prepare ("SELECT name, data FROM foo ORDER BY id");
+    Result result = select.execute ();
+
+    std::string_view name;
+    BlobView blob;
+
+    result >> name >> blob;
+
+    ASSERT_EQ (name, "Jane");
+    ASSERT_EQ (blob.size (), sizeof (std::uint16_t) * data.size ());
+    ASSERT_EQ (std::memcmp (blob.data (), data.data (), blob.size ()), 0);
+
+    ++result;
+    result >> name >> blob;
+
+    ASSERT_TRUE (name.empty ());
+    ASSERT_TRUE (blob.empty ());
+}
+
+TEST (database, results_can_be_fetched_column_by_column)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT, weight REAL, data BLOB)";
+    db << "INSERT INTO foo (id, name, weight, data) VALUES "
+          "(1, NULL, 1.5, NULL), (2, 'Sue', NULL, NULL), (3, 'Marc', 3.5, x'0102')";
+
+    Statement select = db.prepare ("SELECT id, name, weight, data FROM foo ORDER BY id");
+    Result result = select.execute ();
+    ColumnBatch batch;
+
+    ASSERT_EQ (result.fetchColumns (2, batch), 2);
+    ASSERT_EQ (batch.columns (), 4);
+    ASSERT_EQ (batch[0].integers (), (std::vector<std::int64_t> {1, 2}));
+    ASSERT_EQ (batch[1].type (), Result::Type::Text);
+    ASSERT_TRUE (batch[1].isNull (0));
+    ASSERT_EQ (batch[1].text (0), "");
+    ASSERT_EQ (batch[1].text (1), "Sue");
+    ASSERT_EQ (batch[2].reals (), (std::vector<double> {1.5, 0.0}));
+    ASSERT_TRUE (batch[2].isNull (1));
+    ASSERT_EQ (batch[3].type (), Result::Type::Null);
+
+    ASSERT_EQ (result.fetchColumns (2, batch), 1);
+    ASSERT_EQ (batch[0].integers (), (std::vector<std::int64_t> {3}));
+    ASSERT_EQ (batch[1].offsets (), (std::vector<std::size_t> {0, 4}));
+    ASSERT_EQ (batch[3].type (), Result::Type::Blob);
+    ASSERT_EQ (batch[3].blob (0).size (), 2);
+    ASSERT_FALSE (batch[3].isNull (0));
+
+    ASSERT_EQ (result.fetchColumns (2, batch), 0);
+    ASSERT_EQ (batch.rows (), 0);
+}
@@ -0,0 +1,94 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * async.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/async.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace cqlite;
+
+TEST (async, requests_are_executed_on_the_worker_thread)
+{
+    AsyncDatabase db {":memory:"};
+
+    db.execute ("CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)");
+
+    std::future<std::int64_t> id = db.submit ([] (Database& db) {
+        db << "INSERT INTO foo (name) VALUES ('Peter')";
+        return db.lastInsertId ();
+    });
+
+    std::future<std::thread::id> worker
+        = db.submit ([] (Database&) { return std::this_thread::get_id (); });
+
+    auto rows = db.fetch<std::int64_t, std::string> (
+        "SELECT id, name FROM foo WHERE id = ?1", 1);
+
+    ASSERT_EQ (id.get (), 1);
+    ASSERT_NE (worker.get (), std::this_thread::get_id ());
+    ASSERT_EQ (rows.get (), (std::vector<std::tuple<std::int64_t, std::string>> {
+                                {1, "Peter"}}));
+
+    ASSERT_THROW (db.execute ("SELECT * FROM bar").get (), Error);
+}
+
+TEST (async, cursors_read_the_rows_in_chunks)
+{
+    AsyncDatabase db {":memory:"};
+
+    db.execute ("CREATE TABLE foo (id INTEGER PRIMARY KEY)");
+    db.execute ("INSERT INTO foo (id) VALUES (1), (2), (3), (4), (5)");
+
+    AsyncCursor<int> cursor = db.cursor<int> ("SELECT id FROM foo WHERE id > ?1", 0);
+
+    ASSERT_EQ (cursor.next (2).get (), (std::vector<std::tuple<int>> {{1}, {2}}));
+    ASSERT_EQ (cursor.next (2).get (), (std::vector<std::tuple<int>> {{3}, {4}}));
+    ASSERT_EQ (cursor.next (2).get (), (std::vector<std::tuple<int>> {{5}}));
+    ASSERT_TRUE (cursor.next (2).get ().empty ());
+}
+
+TEST (async, cursors_can_be_moved_over_open_cursors)
+{
+    AsyncDatabase db {":memory:"};
+
+    db.execute ("CREATE TABLE foo (id INTEGER PRIMARY KEY)");
+    db.execute ("INSERT INTO foo (id) VALUES (1), (2), (3)");
+
+    AsyncCursor<int> cursor = db.cursor<int> ("SELECT id FROM foo WHERE id > ?1", 0);
+    ASSERT_EQ (cursor.next (1).get (), (std::vector<std::tuple<int>> {{1}}));
+
+    AsyncCursor<int> other = db.cursor<int> ("SELECT id FROM foo WHERE id > ?1", 1);
+    cursor = std::move (other);
+
+    ASSERT_EQ (cursor.next (3).get (), (std::vector<std::tuple<int>> {{2}, {3}}));
+    ASSERT_THROW (other.next (1), StatementError);
+}
@@ -0,0 +1,121 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * backup.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/backup.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace cqlite;
+
+namespace {
+    const char* const PATH = "cqlite_backup_test.db";
+
+    void fill (Database& db)
+    {
+        db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+
+        Statement insert = db.prepare ("INSERT INTO foo (name) VALUES (?1)");
+        insert.executeMany (std::vector<std::string> (1000, std::string (100, 'x')));
+    }
+
+    std::size_t count (Database& db)
+    {
+        std::size_t count;
+        db.prepare ("SELECT COUNT (*) FROM foo").execute () >> count;
+
+        return count;
+    }
+
+    struct BackupTest : ::testing::Test
+    {
+        void SetUp () override { std::remove (PATH); }
+        void TearDown () override { std::remove (PATH); }
+    };
+} // namespace
+
+TEST_F (BackupTest, databases_are_copied_step_by_step)
+{
+    Database source {":memory:"};
+    Database copy {":memory:"};
+    fill (source);
+
+    Backup backup {source, copy};
+    std::vector<std::size_t> remaining;
+
+    backup.run (10, std::chrono::milliseconds {0},
+        [&remaining] (const Backup::Progress& progress) {
+            remaining.push_back (progress.remaining);
+        });
+
+    ASSERT_TRUE (backup.done ());
+    ASSERT_GT (remaining.size (), 2);
+    ASSERT_EQ (remaining.back (), 0);
+    ASSERT_EQ (remaining.size (), (backup.progress ().total + 9) / 10);
+    ASSERT_EQ (count (copy), 1000);
+}
+
+TEST_F (BackupTest, cancelled_copies_are_continued)
+{
+    Database source {":memory:"};
+    Database copy {":memory:"};
+    fill (source);
+
+    Backup backup {source, copy};
+
+    backup.run (10, std::chrono::milliseconds {0},
+        [&backup] (const Backup::Progress&) { backup.cancel (); });
+
+    ASSERT_FALSE (backup.done ());
+
+    backup.run (10);
+
+    ASSERT_TRUE (backup.done ());
+    ASSERT_EQ (count (copy), 1000);
+}
+
+TEST_F (BackupTest, databases_are_copied_to_files_in_the_background)
+{
+    Database source {":memory:", Database::ReadWrite | Database::FullMutex};
+    fill (source);
+
+    {
+        Backup backup {source, PATH};
+        std::future<void> finished = backup.start (5, std::chrono::milliseconds {1});
+
+        ASSERT_THROW (backup.run (5), BackupError);
+        finished.get ();
+
+        ASSERT_TRUE (backup.done ());
+        ASSERT_NO_THROW (backup.start (5).get ());
+    }
+
+    Database copy {PATH};
+    ASSERT_EQ (count (copy), 1000);
+}
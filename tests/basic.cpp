@@ -26,11 +26,22 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
+
 using namespace cqlite;
 
 namespace {
     const char* const NAME = "Jane ''Fonda'";
     const std::size_t COUNT = 10;
+    const char* const PATH = "cqlite_basic_test.db";
+
+    void removeDatabase ()
+    {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::remove ((std::string {PATH} + suffix).c_str ());
+        }
+    }
 } // namespace
 
 Database create ()
@@ -90,3 +101,28 @@ TEST (database, inserting_and_retrieving_values_from_one_table_succeeds)
     ASSERT_EQ (count, COUNT);
 }
 
+TEST (database, options_are_applied_when_opening)
+{
+    removeDatabase ();
+
+    DatabaseOptions wanted = DatabaseOptions::durableOltp ();
+    wanted.pageSize = 8192;
+    wanted.lookaside = DatabaseOptions::Lookaside {128, 64};
+
+    {
+        Database db {PATH, wanted};
+        DatabaseOptions options = db.options ();
+
+        ASSERT_EQ (options.journalMode, DatabaseOptions::JournalMode::Wal);
+        ASSERT_EQ (options.synchronous, DatabaseOptions::Synchronous::Full);
+        ASSERT_EQ (options.cacheSize, -16 * 1024);
+        ASSERT_EQ (options.pageSize, 8192);
+        ASSERT_EQ (options.walAutocheckpoint, 1000);
+        ASSERT_EQ (options.foreignKeys, true);
+        ASSERT_FALSE (options.lookaside);
+    }
+
+    removeDatabase ();
+
+    ASSERT_THROW ((Database {":memory:", DatabaseOptions::readHeavy ()}), DbError);
+}
@@ -0,0 +1,133 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * blob.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/blob.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+using namespace cqlite;
+
+namespace {
+    std::string pattern (std::size_t size)
+    {
+        std::string data (size, '\0');
+
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<char> ('a' + i % 26);
+        }
+
+        return data;
+    }
+
+    std::int64_t insertZeros (Database& db, std::size_t size)
+    {
+        Statement insert = db.prepare ("INSERT INTO files (data) VALUES (?1)");
+        insert << ZeroBlob {size};
+        insert.execute ();
+
+        return db.lastInsertId ();
+    }
+} // namespace
+
+TEST (blob, blobs_are_written_and_read_in_chunks)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE files (id INTEGER PRIMARY KEY, data BLOB)";
+
+    const std::string data = pattern (10000);
+    const std::int64_t id = insertZeros (db, data.size ());
+
+    {
+        BlobStream file {db, "files", "data", id, BlobStream::Access::ReadWrite, 256};
+
+        ASSERT_EQ (file.size (), data.size ());
+
+        std::istringstream source {data};
+        file << source.rdbuf ();
+        ASSERT_TRUE (file.flush ());
+
+        // Nothing is written past the end of the blob.
+        file << 'x';
+        file.flush ();
+        ASSERT_FALSE (file);
+    }
+
+    BlobStream file {db, "files", "data", id, BlobStream::Access::ReadOnly, 100};
+    const std::string read {
+        std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+
+    ASSERT_EQ (read, data);
+
+    file.clear ();
+    file.seekg (-3, std::ios_base::end);
+
+    std::string tail;
+    file >> tail;
+
+    ASSERT_EQ (tail, data.substr (data.size () - 3));
+}
+
+TEST (blob, streams_can_be_reopened_and_refuse_unknown_rows)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE files (id INTEGER PRIMARY KEY, data BLOB)";
+    db << "INSERT INTO files (id, data) VALUES (1, X'0102'), (2, X'03040506')";
+
+    BlobStream file {db, "files", "data", 1};
+    ASSERT_EQ (file.size (), 2);
+
+    file.reopen (2);
+    ASSERT_EQ (file.size (), 4);
+    ASSERT_EQ (file.get (), 3);
+
+    ASSERT_THROW (file.reopen (3), BlobError);
+    ASSERT_THROW ((BlobStream {db, "files", "data", 3}), BlobError);
+    ASSERT_THROW ((BlobStream {db, "files", "missing", 1}), BlobError);
+}
+
+TEST (blob, changed_rows_fail_the_stream)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE files (id INTEGER PRIMARY KEY, data BLOB)";
+    db << "INSERT INTO files (id, data) VALUES (1, X'01020304050607080910')";
+
+    BlobStream file {db, "files", "data", 1, BlobStream::Access::ReadOnly, 4};
+
+    ASSERT_EQ (file.get (), 1);
+    ASSERT_EQ (file.tellg (), 1);
+    ASSERT_EQ (file.get (), 2);
+
+    db << "UPDATE files SET data = X'0A0B' WHERE id = 1";
+
+    char rest[8];
+    file.read (rest, sizeof (rest));
+
+    ASSERT_TRUE (file.bad ());
+}
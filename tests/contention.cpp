@@ -0,0 +1,108 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * contention.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/contention.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/transaction.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace cqlite;
+
+namespace {
+    const char* const PATH = "cqlite_contention_test.db";
+
+    struct ContentionTest : ::testing::Test
+    {
+        void SetUp () override
+        {
+            std::remove (PATH);
+
+            Database db {PATH};
+            db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+        }
+
+        void TearDown () override { std::remove (PATH); }
+    };
+} // namespace
+
+TEST_F (ContentionTest, a_policy_gives_up_after_its_timeout_and_reports_the_wait)
+{
+    Database holder {PATH};
+    Database waiter {PATH};
+
+    auto policy = std::make_shared<ExponentialBackoff> (std::chrono::milliseconds {30});
+    waiter.setContentionPolicy (policy);
+
+    Transaction transaction {holder, Transaction::Type::Immediate};
+
+    ASSERT_THROW (
+        waiter << "INSERT INTO foo (name) VALUES ('Sue')", DbError);
+
+    ContentionPolicy::Stats stats = policy->stats ();
+
+    ASSERT_EQ (stats.contentions, 1);
+    ASSERT_EQ (stats.failures, 1);
+    ASSERT_GT (stats.retries, 0);
+    ASSERT_GE (stats.waited, std::chrono::milliseconds {25});
+    ASSERT_GE (stats.longestWait, std::chrono::milliseconds {25});
+
+    policy->resetStats ();
+
+    ASSERT_EQ (policy->stats ().contentions, 0);
+}
+
+TEST_F (ContentionTest, a_policy_waits_until_the_lock_is_released)
+{
+    Database holder {PATH};
+    Database waiter {PATH};
+
+    auto policy = std::make_shared<BusyTimeout> (std::chrono::seconds {5});
+    waiter.setContentionPolicy (policy);
+
+    Statement insert = waiter.prepare ("INSERT INTO foo (name) VALUES (?1)");
+    insert << "Sue";
+
+    holder << "BEGIN IMMEDIATE";
+
+    std::thread release {[&holder] {
+        std::this_thread::sleep_for (std::chrono::milliseconds {20});
+        holder << "COMMIT";
+    }};
+
+    ASSERT_NO_THROW (insert.execute ());
+    release.join ();
+
+    ContentionPolicy::Stats stats = policy->stats ();
+
+    ASSERT_EQ (stats.contentions, 1);
+    ASSERT_EQ (stats.failures, 0);
+    ASSERT_GT (stats.waited, std::chrono::milliseconds::zero ());
+}
@@ -0,0 +1,147 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * functions.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/database.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace cqlite;
+
+namespace {
+    struct Mean
+    {
+        double sum = 0;
+        std::size_t count = 0;
+    };
+
+    Database& createDatabase (Database& db)
+    {
+        db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT, weight REAL)";
+        db << "INSERT INTO foo (name, weight) VALUES "
+              "('Peter', 1.5), ('Sue', 2.5), (NULL, 5.0)";
+
+        return db;
+    }
+} // namespace
+
+TEST (functions, scalar_functions_decode_their_arguments)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    db.createFunction (
+          "score",
+          [] (std::optional<std::string_view> name, double weight) {
+              return name ? static_cast<double> (name->size ()) * weight : -1.0;
+          },
+          true)
+        .createFunction ("shout", [] (const std::string& text) { return text + "!"; });
+
+    double score;
+    std::string shouted;
+
+    db.prepare ("SELECT SUM (score (name, weight)) FROM foo").execute () >> score;
+    db.prepare ("SELECT shout (name) FROM foo WHERE id = 2").execute () >> shouted;
+
+    ASSERT_DOUBLE_EQ (score, 5 * 1.5 + 3 * 2.5 - 1.0);
+    ASSERT_EQ (shouted, "Sue!");
+}
+
+TEST (functions, empty_blobs_are_returned_as_blobs)
+{
+    Database db {":memory:"};
+
+    db.createFunction ("empty", [] (std::int64_t) { return BlobView {}; });
+
+    std::string type;
+    std::size_t length;
+
+    db.prepare ("SELECT TYPEOF (empty (1)), LENGTH (empty (1))").execute ()
+        >> type >> length;
+
+    ASSERT_EQ (type, "blob");
+    ASSERT_EQ (length, 0);
+}
+
+TEST (functions, exceptions_fail_the_statement)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    db.createFunction ("fail", [] (std::int64_t id) -> std::int64_t {
+        throw std::runtime_error {"failed on " + std::to_string (id)};
+    });
+
+    try {
+        db.prepare ("SELECT fail (id) FROM foo").execute ();
+        FAIL () << "The statement did not fail";
+    }
+    catch (const QueryError& error) {
+        ASSERT_NE (std::string {error.what ()}.find ("failed on 1"), std::string::npos);
+    }
+
+    ASSERT_THROW (db.prepare ("SELECT fail (id, id) FROM foo"), DbError);
+}
+
+TEST (functions, aggregates_keep_a_state_per_group)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    db.createAggregate<Mean> (
+        "mean",
+        [] (Mean& mean, double value) {
+            mean.sum += value;
+            ++mean.count;
+        },
+        [] (const Mean& mean) -> std::optional<double> {
+            if (mean.count == 0) {
+                return std::nullopt;
+            }
+
+            return mean.sum / static_cast<double> (mean.count);
+        });
+
+    double mean;
+    db.prepare ("SELECT mean (weight) FROM foo").execute () >> mean;
+
+    ASSERT_DOUBLE_EQ (mean, 3.0);
+
+    Statement empty = db.prepare ("SELECT mean (weight) FROM foo WHERE id > 3");
+    std::size_t rows = 0;
+
+    for (auto [nothing] : empty.rows<std::optional<double>> ()) {
+        ASSERT_FALSE (nothing);
+        ++rows;
+    }
+
+    ASSERT_EQ (rows, 1);
+}
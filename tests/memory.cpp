@@ -0,0 +1,103 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * memory.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/database.hpp>
+#include <cqlite/memory.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sqlite3.h>
+
+#include <cstddef>
+
+using namespace cqlite;
+
+namespace {
+    void fill (Database& db)
+    {
+        db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+        db << "WITH RECURSIVE n (i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n "
+              "WHERE i < 1000) INSERT INTO foo SELECT i, 'name ' || i FROM n";
+    }
+} // namespace
+
+TEST (memory, lookaside_and_page_cache_usage_is_reported_per_connection)
+{
+    DatabaseOptions options;
+    options.lookaside = DatabaseOptions::Lookaside {128, 64};
+
+    Database db {":memory:", options};
+    fill (db);
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        std::size_t count;
+        db.prepare ("SELECT COUNT (*) FROM foo WHERE name LIKE '%1%'").execute ()
+            >> count;
+    }
+
+    ConnectionMemoryStats stats = db.memoryStats (true);
+
+    // Distributions may build sqlite without any lookaside memory.
+    if (! sqlite3_compileoption_used ("OMIT_LOOKASIDE")) {
+        ASSERT_GT (stats.lookasideHits, 0);
+        ASSERT_GT (stats.lookasideHighWater, 0);
+    }
+
+    ASSERT_LE (stats.lookasideUsed, 64);
+    ASSERT_GT (stats.cacheUsed, 0);
+    ASSERT_GT (stats.cacheHits, 0);
+
+    stats = db.memoryStats ();
+
+    ASSERT_EQ (stats.lookasideHits, 0);
+    ASSERT_EQ (stats.lookasideMisses, 0);
+    ASSERT_EQ (stats.cacheHits, 0);
+    ASSERT_EQ (stats.cacheMisses, 0);
+}
+
+TEST (memory, the_page_cache_arena_is_configured_before_sqlite_is_initialized)
+{
+    {
+        Database db {":memory:"};
+        ASSERT_THROW (configurePageCache (4096, 64), MemoryError);
+    }
+
+    sqlite3_shutdown ();
+    configurePageCache (4096, 64);
+
+    {
+        Database db {":memory:"};
+        fill (db);
+
+        MemoryStats stats = memoryStats ();
+
+        ASSERT_GT (stats.pageCacheUsed, 0);
+        ASSERT_GT (stats.memoryUsed, 0);
+        ASSERT_GE (stats.memoryHighWater, stats.memoryUsed);
+        ASSERT_GT (stats.mallocHighWater, 0);
+    }
+
+    sqlite3_shutdown ();
+    configurePageCache (0, 0);
+}
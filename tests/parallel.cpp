@@ -0,0 +1,121 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * parallel.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/parallel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace cqlite;
+
+namespace {
+    const char* const PATH = "cqlite_parallel_test.db";
+
+    void removeDatabase ()
+    {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::remove ((std::string {PATH} + suffix).c_str ());
+        }
+    }
+
+    struct ParallelScanTest : ::testing::Test
+    {
+        void SetUp () override
+        {
+            removeDatabase ();
+
+            Database db {PATH};
+            db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, value INTEGER)";
+            db << "WITH RECURSIVE n (i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n "
+                  "WHERE i < 1000) INSERT INTO foo SELECT i, i * 3 FROM n";
+        }
+
+        void TearDown () override { removeDatabase (); }
+    };
+} // namespace
+
+TEST (parallel, splits_the_keys_into_ranges)
+{
+    ParallelScan scan {PATH, 4};
+
+    ASSERT_THROW (scan.ranges (), ParallelScanError);
+
+    std::vector<ParallelScan::Range> ranges = scan.keys (1, 10).ranges ();
+
+    ASSERT_EQ (ranges.size (), 4);
+    ASSERT_EQ (ranges.front ().first, 1);
+    ASSERT_EQ (ranges.back ().last, 10);
+
+    for (std::size_t i = 1; i < ranges.size (); ++i) {
+        ASSERT_EQ (ranges[i].first, ranges[i - 1].last + 1);
+    }
+
+    ASSERT_EQ (scan.keys (5, 6).ranges ().size (), 2);
+    ASSERT_TRUE (scan.keys (1, 0).ranges ().empty ());
+
+    ranges = scan.keys (INT64_MIN, INT64_MAX).ranges ();
+
+    ASSERT_EQ (ranges.size (), 4);
+    ASSERT_EQ (ranges.front ().first, INT64_MIN);
+    ASSERT_EQ (ranges.back ().last, INT64_MAX);
+}
+
+TEST_F (ParallelScanTest, shards_are_reduced_to_the_result_of_a_single_scan)
+{
+    ParallelScan scan {PATH, 3};
+    scan.keys ("SELECT MIN (id), MAX (id) FROM foo");
+
+    std::int64_t sum = scan.reduce<std::int64_t> (
+        "SELECT value FROM foo WHERE id BETWEEN ?1 AND ?2", std::int64_t {0},
+        [] (std::int64_t& partial, std::int64_t value) { partial += value; },
+        [] (std::int64_t& total, std::int64_t partial) { total += partial; });
+
+    Database db {PATH};
+    std::int64_t expected;
+    db.prepare ("SELECT SUM (value) FROM foo").execute () >> expected;
+
+    ASSERT_EQ (sum, expected);
+
+    std::vector<std::tuple<std::int64_t, std::string>> rows =
+        scan.collect<std::int64_t, std::string> (
+            "SELECT id, CAST (value AS TEXT) FROM foo WHERE id BETWEEN ?1 AND ?2 "
+            "ORDER BY id");
+
+    ASSERT_EQ (rows.size (), 1000);
+
+    for (std::size_t i = 0; i < rows.size (); ++i) {
+        ASSERT_EQ (std::get<0> (rows[i]), i + 1);
+        ASSERT_EQ (std::get<1> (rows[i]), std::to_string (3 * (i + 1)));
+    }
+
+    ASSERT_THROW (scan.collect<std::int64_t> ("SELECT id FROM foo"), StatementError);
+    ASSERT_THROW (
+        scan.collect<std::int64_t> ("SELECT id FROM foo WHERE id BETWEEN ?1 AND ?2 + x"),
+        DbError);
+}
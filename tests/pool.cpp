@@ -0,0 +1,148 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * pool.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/pool.hpp>
+#include <cqlite/transaction.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cqlite;
+
+namespace {
+    const char* const PATH = "cqlite_pool_test.db";
+
+    void removeDatabase ()
+    {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::remove ((std::string {PATH} + suffix).c_str ());
+        }
+    }
+
+    /** Creates the database file of a test and removes it when the test ends. */
+    struct TestDatabase
+    {
+        TestDatabase ()
+        {
+            removeDatabase ();
+
+            Database db {PATH};
+            db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+        }
+
+        ~TestDatabase () { removeDatabase (); }
+    };
+} // namespace
+
+TEST (pool, writes_go_to_the_writer_and_reads_to_the_readers)
+{
+    TestDatabase file;
+    DatabasePool pool {PATH, 2};
+
+    Database* writer = &*pool.writer ();
+
+    {
+        PooledStatement insert = pool.prepare ("INSERT INTO foo (name) VALUES (?1)");
+        *insert << "Sue";
+        insert->execute ();
+
+        ASSERT_EQ (&insert.database (), writer);
+    }
+
+    PooledStatement select = pool.prepare ("SELECT name FROM foo");
+
+    ASSERT_NE (&select.database (), writer);
+
+    std::string name;
+    select->execute () >> name;
+
+    ASSERT_EQ (name, "Sue");
+
+    for (const char* control : {"BEGIN", " commit", "SAVEPOINT a", "RELEASE a"}) {
+        ASSERT_EQ (&pool.prepare (control).database (), writer);
+    }
+}
+
+TEST (pool, transactions_run_on_one_lease_of_the_writer)
+{
+    TestDatabase file;
+    DatabasePool pool {PATH, 2};
+
+    {
+        DatabasePool::Lease writer = pool.writer ();
+
+        ASSERT_THROW (pool.prepare ("INSERT INTO foo (name) VALUES ('Sue')"), PoolError);
+        ASSERT_THROW (pool.writer (), PoolError);
+
+        Transaction transaction {*writer, Transaction::Type::Immediate};
+        writer->prepare ("INSERT INTO foo (name) VALUES ('Sue')").execute ();
+        writer->prepare ("INSERT INTO foo (name) VALUES ('Peter')").execute ();
+
+        std::size_t count;
+        pool.prepare ("SELECT COUNT (*) FROM foo")->execute () >> count;
+        ASSERT_EQ (count, 0);
+
+        transaction.commit ();
+    }
+
+    std::size_t count;
+    pool.prepare ("SELECT COUNT (*) FROM foo")->execute () >> count;
+    ASSERT_EQ (count, 2);
+}
+
+TEST (pool, readers_can_be_leased_concurrently)
+{
+    TestDatabase file;
+    const std::size_t Readers = 4;
+    DatabasePool pool {PATH, Readers};
+
+    {
+        DatabasePool::Lease writer = pool.writer ();
+        *writer << "INSERT INTO foo (name) VALUES ('Peter')";
+    }
+
+    std::atomic<std::size_t> found {0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < 2 * Readers; ++i) {
+        threads.emplace_back ([&pool, &found] {
+            for (std::size_t j = 0; j < 10; ++j) {
+                std::size_t count;
+                pool.prepare ("SELECT COUNT (*) FROM foo")->execute () >> count;
+                found += count;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join ();
+    }
+
+    ASSERT_EQ (found, 2 * Readers * 10);
+}
@@ -0,0 +1,139 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * session.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/session.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace cqlite;
+
+namespace {
+    Database& createDatabase (Database& db)
+    {
+        db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+        db << "CREATE TABLE bar (id INTEGER PRIMARY KEY, name TEXT)";
+
+        return db;
+    }
+
+    std::vector<std::string> names (Database& db)
+    {
+        std::vector<std::string> result;
+        Statement select = db.prepare ("SELECT name FROM foo ORDER BY id");
+
+        for (auto [name] : select.rows<std::string> ()) {
+            result.push_back (name);
+        }
+
+        return result;
+    }
+} // namespace
+
+TEST (session, changesets_replicate_the_attached_tables)
+{
+    Database db {":memory:"};
+    Database replica {":memory:"};
+    createDatabase (db);
+    createDatabase (replica);
+
+    Session session {db};
+    session.attach ("foo");
+
+    ASSERT_TRUE (session.empty ());
+
+    db << "INSERT INTO foo (id, name) VALUES (1, 'Peter'), (2, 'Sue')";
+    db << "INSERT INTO bar (id, name) VALUES (1, 'Marc')";
+    db << "UPDATE foo SET name = 'Susan' WHERE id = 2";
+
+    Changeset changeset = session.changeset ();
+
+    ASSERT_FALSE (changeset.empty ());
+    ASSERT_LE (session.patchset ().size (), changeset.size ());
+
+    Session::apply (replica, changeset);
+
+    ASSERT_EQ (names (replica), (std::vector<std::string> {"Peter", "Susan"}));
+
+    std::size_t bars;
+    replica.prepare ("SELECT COUNT (*) FROM bar").execute () >> bars;
+    ASSERT_EQ (bars, 0);
+
+    Session::apply (replica, changeset.invert ());
+
+    ASSERT_TRUE (names (replica).empty ());
+}
+
+TEST (session, streamed_changes_are_applied_with_conflict_handlers)
+{
+    Database db {":memory:"};
+    Database replica {":memory:"};
+    createDatabase (db);
+    createDatabase (replica);
+
+    replica << "INSERT INTO foo (id, name) VALUES (1, 'Paul')";
+
+    Session session {db};
+    session.attachAll ();
+
+    db << "INSERT INTO foo (id, name) VALUES (1, 'Peter'), (2, 'Sue')";
+
+    std::vector<unsigned char> stream;
+    session.changeset ([&stream] (BlobView chunk) {
+        const unsigned char* data = static_cast<const unsigned char*> (chunk.data ());
+        stream.insert (stream.end (), data, data + chunk.size ());
+    });
+
+    std::size_t position = 0;
+    Session::Reader reader = [&stream, &position] (void* buffer, std::size_t size) {
+        size = std::min (size, stream.size () - position);
+        std::memcpy (buffer, stream.data () + position, size);
+        position += size;
+
+        return size;
+    };
+
+    ASSERT_THROW (Session::apply (replica, reader), SessionError);
+    ASSERT_EQ (names (replica), (std::vector<std::string> {"Paul"}));
+
+    std::vector<Session::Conflict> conflicts;
+    position = 0;
+
+    Session::apply (replica, reader,
+        [&conflicts] (Session::Conflict conflict, std::string_view table) {
+            EXPECT_EQ (table, "foo");
+            conflicts.push_back (conflict);
+
+            return Session::Resolution::Replace;
+        });
+
+    ASSERT_EQ (
+        conflicts, (std::vector<Session::Conflict> {Session::Conflict::Duplicate}));
+    ASSERT_EQ (names (replica), (std::vector<std::string> {"Peter", "Sue"}));
+}
@@ -0,0 +1,128 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * snapshot.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/cqlite_config.hpp>
+#include <cqlite/database.hpp>
+#include <cqlite/parallel.hpp>
+#include <cqlite/transaction.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+using namespace cqlite;
+
+namespace {
+    const char* const PATH = "cqlite_snapshot_test.db";
+
+    void removeDatabase ()
+    {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::remove ((std::string {PATH} + suffix).c_str ());
+        }
+    }
+
+    std::size_t count (Database& db)
+    {
+        std::size_t count;
+        db.prepare ("SELECT COUNT (*) FROM foo").execute () >> count;
+
+        return count;
+    }
+
+    struct SnapshotTest : ::testing::Test
+    {
+        void SetUp () override
+        {
+            removeDatabase ();
+
+            Database db {PATH};
+            db << "PRAGMA journal_mode = WAL";
+            db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+            db << "INSERT INTO foo (name) VALUES ('Peter')";
+        }
+
+        void TearDown () override { removeDatabase (); }
+    };
+} // namespace
+
+#ifdef CQLITE_HAVE_SNAPSHOT
+TEST_F (SnapshotTest, readers_see_the_state_of_the_snapshot)
+{
+    Database writer {PATH};
+    Database reader {PATH};
+
+    // Keeps the WAL file from being checkpointed and restarted.
+    Transaction keep {writer};
+    ASSERT_EQ (count (writer), 1);
+
+    Database snapshotter {PATH};
+
+    // Closing the connections of the set up removed the WAL, a snapshot needs a
+    // transaction written to it.
+    snapshotter << "INSERT INTO foo (name) VALUES ('Paul')";
+    Snapshot snapshot = snapshotter.snapshot ();
+
+    snapshotter << "INSERT INTO foo (name) VALUES ('Sue')";
+
+    {
+        Transaction read {reader};
+        reader.openSnapshot (snapshot);
+
+        ASSERT_EQ (count (reader), 2);
+    }
+
+    ASSERT_EQ (count (reader), 3);
+    ASSERT_LT (snapshot, snapshotter.snapshot ());
+    ASSERT_THROW (reader.openSnapshot (snapshot), SnapshotError);
+}
+
+TEST_F (SnapshotTest, parallel_scans_read_the_given_snapshot)
+{
+    Database writer {PATH};
+    writer << "INSERT INTO foo (name) VALUES ('Paul')";
+
+    Snapshot snapshot = writer.snapshot ();
+    writer << "INSERT INTO foo (name) VALUES ('Sue')";
+
+    ParallelScan scan {PATH, 2};
+    scan.keys (1, 3);
+
+    const std::string sql {"SELECT id FROM foo WHERE id BETWEEN ?1 AND ?2"};
+
+    ASSERT_EQ (scan.collect<std::int64_t> (sql, &snapshot).size (), 2);
+    ASSERT_EQ (scan.collect<std::int64_t> (sql).size (), 3);
+}
+#else
+TEST_F (SnapshotTest, snapshots_are_refused_without_support)
+{
+    Database db {PATH};
+
+    ASSERT_THROW (db.snapshot (), SnapshotError);
+    ASSERT_EQ (count (db), 1);
+}
+#endif
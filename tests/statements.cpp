@@ -24,10 +24,16 @@
  */
 #include <cqlite/database.hpp>
 #include <cqlite/datetime.hpp>
+#include <cqlite/typed.hpp>
 
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 using namespace cqlite;
 
@@ -51,6 +57,17 @@ namespace {
 
         return count;
     }
+
+    struct Person
+    {
+        std::string name;
+        DateTime createdAt;
+    };
+
+    Statement& operator<< (Statement& statement, const Person& person)
+    {
+        return statement << person.name << person.createdAt;
+    }
 } // namespace
 
 TEST (statement, reset_and_reassign_succeeds_in_inserting_multiple_values)
@@ -108,3 +125,319 @@ TEST (statement, date_time_can_be_inserted)
     ASSERT_EQ (now, extracted);
 }
 
+TEST (statement, cached_statements_are_reused_with_cleared_bindings)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+    db.cacheStatements (4);
+
+    for (const char* name : {"Peter", "Sue", "Marc"}) {
+        Statement insert = db.prepare ("INSERT INTO foo (name) VALUES (?1)");
+        insert << name;
+        insert.execute ();
+    }
+
+    {
+        // bindings are cleared when the statement goes back to the cache
+        Statement insert = db.prepare ("INSERT INTO foo (name) VALUES (?1)");
+        insert.execute ();
+    }
+
+    ASSERT_EQ (countNames (db), 3);
+
+    StatementCache::Stats stats = db.statementCacheStats ();
+
+    ASSERT_EQ (stats.hits, 3);
+    ASSERT_EQ (stats.misses, 2);
+    ASSERT_EQ (stats.size, 2);
+    ASSERT_EQ (stats.capacity, 4);
+}
+
+TEST (statement, the_statement_cache_evicts_the_least_recently_used_statement)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+    db.cacheStatements (1);
+
+    {
+        Statement first = db.prepare ("SELECT name FROM foo");
+        // the same sql while the first one is leased is compiled on its own
+        Statement second = db.prepare ("SELECT name FROM foo");
+    }
+
+    db.prepare ("SELECT id FROM foo");
+    db.prepare ("SELECT name FROM foo");
+
+    StatementCache::Stats stats = db.statementCacheStats ();
+
+    ASSERT_EQ (stats.hits, 0);
+    ASSERT_EQ (stats.misses, 4);
+    ASSERT_EQ (stats.size, 1);
+}
+
+TEST (statement, many_tuples_can_be_inserted_at_once)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    std::vector<std::tuple<int, std::string>> rows;
+
+    for (int i = 1; i <= 25; ++i) {
+        rows.emplace_back (i, "Peter " + std::to_string (i));
+    }
+
+    Statement insert = db.prepare ("INSERT INTO foo (id, name) VALUES (?1, ?2)");
+
+    ASSERT_EQ (insert.executeMany (rows, 10), rows.size ());
+    ASSERT_EQ (countNames (db), rows.size ());
+}
+
+TEST (statement, many_structs_can_be_inserted_at_once)
+{
+    Database db {":memory:"};
+    db << "CREATE TABLE foo ("
+          "id INTEGER PRIMARY KEY, "
+          "name TEXT, "
+          "created_at INTEGER NOT NULL DEFAULT 0"
+          ")";
+
+    const std::vector<Person> people {
+        {"Peter", DateTime::clock::now ()}, {"Sue", DateTime::clock::now ()}};
+
+    Statement insert = db.prepare ("INSERT INTO foo (name, created_at) VALUES (?1, ?2)");
+
+    ASSERT_EQ (insert.executeMany (people), people.size ());
+    ASSERT_EQ (countNames (db), people.size ());
+}
+
+TEST (statement, only_rows_that_are_changed_are_counted)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    const std::vector<std::tuple<int, std::string>> rows {{1, "Peter"}, {2, "Sue"}};
+
+    Statement insert = db.prepare ("INSERT INTO foo (id, name) VALUES (?1, ?2)");
+    ASSERT_EQ (insert.executeMany (rows), 2);
+
+    Statement select = db.prepare ("SELECT name FROM foo WHERE id = ?1");
+    ASSERT_EQ (select.executeMany (std::vector<int> {1, 2}), 0);
+
+    Statement ignore = db.prepare (
+        "INSERT INTO foo (id, name) VALUES (?1, ?2) ON CONFLICT DO NOTHING");
+    ASSERT_EQ (ignore.executeMany (rows), 0);
+
+    Statement rename = db.prepare ("UPDATE foo SET name = ?2 WHERE id = ?1 RETURNING id");
+    ASSERT_EQ (rename.executeMany (rows), 2);
+    ASSERT_EQ (countNames (db), 2);
+}
+
+TEST (statement, a_failing_row_rolls_back_the_open_transaction)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    const std::vector<std::tuple<int, std::string>> rows {
+        {1, "Peter"}, {2, "Sue"}, {3, "Marc"}, {3, "Marc"}};
+
+    Statement insert = db.prepare ("INSERT INTO foo (id, name) VALUES (?1, ?2)");
+
+    ASSERT_THROW (insert.executeMany (rows, 2), QueryError);
+    ASSERT_EQ (countNames (db), 2);
+}
+
+TEST (statement, parameters_can_be_bound_by_name_and_index)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    Statement insert = db.prepare ("INSERT INTO foo (id, name) VALUES (:id, ?2)");
+    insert.bind (2, "Peter");
+
+    for (int id = 1; id <= 3; ++id) {
+        insert.reset ();
+        insert.bind (":id", id);
+        insert.execute ();
+    }
+
+    ASSERT_EQ (insert.parameter (":id"), 1);
+    ASSERT_THROW (insert.bind (":name", "Sue"), StatementError);
+    ASSERT_THROW (insert.bind (3, "Sue"), StatementError);
+
+    insert.reset ();
+    insert.clearBindings ();
+    insert.bind (":id", 4);
+    insert.execute ();
+
+    std::size_t named, nulls;
+    db.prepare ("SELECT COUNT (*) FROM foo WHERE name = 'Peter'").execute () >> named;
+    db.prepare ("SELECT COUNT (*) FROM foo WHERE name IS NULL").execute () >> nulls;
+
+    ASSERT_EQ (named, 3);
+    ASSERT_EQ (nulls, 1);
+}
+
+TEST (statement, rows_are_decoded_into_typed_tuples)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    db << "INSERT INTO foo (id, name) VALUES (1, 'Peter'), (2, NULL), (3, 'Sue')";
+
+    Statement select = db.prepare ("SELECT id, name, name FROM foo ORDER BY id");
+
+    std::vector<std::tuple<std::int64_t, std::string, std::optional<std::string>>> rows;
+
+    for (auto [id, name, nullable] :
+        select.rows<std::int64_t, std::string_view, std::optional<std::string>> ()) {
+        rows.emplace_back (id, std::string {name}, nullable);
+    }
+
+    ASSERT_EQ (rows.size (), 3);
+    ASSERT_EQ (
+        rows[0], std::make_tuple (1, "Peter", std::optional<std::string> {"Peter"}));
+    ASSERT_EQ (std::get<1> (rows[1]), "");
+    ASSERT_FALSE (std::get<2> (rows[1]));
+    ASSERT_EQ (std::get<1> (rows[2]), "Sue");
+
+    ASSERT_THROW ((select.rows<std::int64_t, std::string_view> ()), StatementError);
+}
+
+TEST (statement, arrays_are_bound_as_table_valued_parameters)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    db << "INSERT INTO foo (id, name) VALUES (1, 'Peter'), (2, 'Sue'), (3, 'Marc')";
+
+    Statement select
+        = db.prepare ("SELECT COUNT (*) FROM foo WHERE id IN cqlite_array (?1)");
+    std::size_t count;
+
+    const std::vector<std::int64_t> ids {1, 3, 5};
+    select << array (ids);
+    select.execute () >> count;
+    ASSERT_EQ (count, 2);
+
+    const std::vector<std::int64_t> more {1, 2, 3, 4};
+    select.reset ();
+    select << array (more);
+    select.execute () >> count;
+    ASSERT_EQ (count, 3);
+
+    const std::vector<std::string> names {"Sue", "Marc", "Paul"};
+    Statement byName = db.prepare (
+        "SELECT value, rowid FROM cqlite_array (?1) WHERE value NOT IN "
+        "(SELECT name FROM foo)");
+    byName << array (names);
+
+    std::string missing;
+    std::int64_t position;
+    byName.execute () >> missing >> position;
+    ASSERT_EQ (missing, "Paul");
+    ASSERT_EQ (position, 3);
+
+    const std::vector<double> weights {0.5, 1.5, 2.5};
+    Statement sum = db.prepare ("SELECT SUM (value) FROM cqlite_array (?1)");
+    sum << array (weights);
+
+    double total;
+    sum.execute () >> total;
+    ASSERT_DOUBLE_EQ (total, 4.5);
+
+    const std::vector<std::string_view> views {"Peter", "Anna"};
+    byName.reset ();
+    byName << array (views);
+    byName.execute () >> missing >> position;
+    ASSERT_EQ (missing, "Anna");
+    ASSERT_EQ (position, 2);
+
+    TypedStatement<Params<ArrayView>, Columns<std::int64_t>> typed {
+        db, "SELECT COUNT (*) FROM foo WHERE id IN cqlite_array (?1)"};
+
+    std::vector<std::tuple<std::int64_t>> found;
+
+    for (const auto& row : typed (array (ids))) {
+        found.push_back (row);
+    }
+
+    ASSERT_EQ (found, (std::vector<std::tuple<std::int64_t>> {{2}}));
+
+    // Any other value than an array is an empty table.
+    select.reset ();
+    select << 1;
+    select.execute () >> count;
+    ASSERT_EQ (count, 0);
+}
+
+TEST (statement, typed_statements_bind_and_read_fixed_types)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+
+    TypedStatement<Params<int, std::optional<std::string>>, Columns<>> insert {
+        db, "INSERT INTO foo (id, name) VALUES (?1, ?2)"};
+
+    insert (1, std::string {"Peter"});
+    insert (2, std::nullopt);
+    insert (3, std::string {"Sue"});
+
+    using Row = Columns<std::int64_t, std::optional<std::string>>;
+    TypedStatement<Params<int>, Row> select {
+        db, "SELECT id, name FROM foo WHERE id >= ?1 ORDER BY id"};
+
+    std::vector<std::tuple<std::int64_t, std::optional<std::string>>> rows;
+
+    for (const auto& row : select (2)) {
+        rows.push_back (row);
+    }
+
+    ASSERT_EQ (rows.size (), 2);
+    ASSERT_FALSE (std::get<1> (rows[0]));
+    ASSERT_EQ (std::get<1> (rows[1]), "Sue");
+
+    using Mismatch = TypedStatement<Params<int, int>, Columns<std::int64_t>>;
+    ASSERT_THROW (Mismatch (db, "SELECT id FROM foo WHERE id = ?1"), StatementError);
+    ASSERT_THROW (Mismatch (db, "SELECT id, name FROM foo WHERE id IN (?1, ?2)"),
+        StatementError);
+}
+
+TEST (statement, metrics_are_aggregated_by_normalized_sql)
+{
+    Database db {":memory:"};
+    createDatabase (db);
+    db.collectMetrics (true);
+
+    db << "INSERT INTO foo (id, name) VALUES (1, 'Peter'), (2, 'Sue')";
+
+    for (int id : {1, 2}) {
+        std::string name;
+        db.prepare ("SELECT name FROM foo WHERE id = " + std::to_string (id)).execute ()
+            >> name;
+    }
+
+    Statement scan
+        = db.prepare ("SELECT name FROM foo WHERE name = 'Sue'  ORDER BY created_at");
+
+    for (Result result = scan.execute (); result; ++result) {
+    }
+
+    StatementMetrics metrics = scan.metrics ();
+
+    ASSERT_EQ (metrics.executions, 1);
+    ASSERT_EQ (metrics.steps, 2);
+    ASSERT_EQ (metrics.fullScanSteps, 1);
+    ASSERT_EQ (metrics.sorts, 1);
+    ASSERT_GT (metrics.vmSteps, 0);
+
+    MetricsRegistry::Snapshot snapshot = db.metrics ()->snapshot ();
+
+    ASSERT_EQ (snapshot.size (), 2);
+    ASSERT_EQ (snapshot["SELECT name FROM foo WHERE id = ?"].executions, 2);
+    ASSERT_EQ (
+        snapshot["SELECT name FROM foo WHERE name = ? ORDER BY created_at"].sorts, 1);
+
+    db.metrics ()->reset ();
+
+    ASSERT_TRUE (db.metrics ()->snapshot ().empty ());
+}
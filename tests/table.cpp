@@ -0,0 +1,117 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * table.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/database.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace cqlite;
+
+namespace {
+    struct Country
+    {
+        std::string code;
+        std::string name;
+        std::int64_t population;
+    };
+
+    const std::vector<Country> Countries {{"CH", "Switzerland", 8700000},
+        {"DE", "Germany", 83200000}, {"FR", "France", 68000000},
+        {"IT", "Italy", 58900000}};
+} // namespace
+
+TEST (table, containers_can_be_queried_as_virtual_tables)
+{
+    Database db {":memory:"};
+
+    db.createVirtualTable ("countries", Countries, key ("code", &Country::code),
+        column ("name", &Country::name),
+        column ("millions",
+            [] (const Country& country) { return country.population / 1000000; }));
+
+    db << "CREATE TABLE cities (name TEXT, country TEXT)";
+    db << "INSERT INTO cities VALUES ('Bern', 'CH'), ('Rome', 'IT'), ('Zurich', 'CH')";
+
+    Statement join = db.prepare ("SELECT cities.name, countries.name, millions "
+                                 "FROM cities JOIN countries ON code = country "
+                                 "ORDER BY cities.name");
+
+    std::vector<std::string> rows;
+
+    for (auto [city, country, millions] :
+        join.rows<std::string_view, std::string_view, int> ()) {
+        rows.push_back (std::string {city} + " " + std::string {country} + " "
+            + std::to_string (millions));
+    }
+
+    ASSERT_EQ (rows,
+        (std::vector<std::string> {
+            "Bern Switzerland 8", "Rome Italy 58", "Zurich Switzerland 8"}));
+
+    std::size_t count;
+    db.prepare ("SELECT COUNT (*) FROM countries").execute () >> count;
+    ASSERT_EQ (count, Countries.size ());
+}
+
+TEST (table, rows_are_looked_up_by_rowid_and_key)
+{
+    Database db {":memory:"};
+
+    db.createVirtualTable ("countries", Countries, column ("name", &Country::name),
+        key ("code", &Country::code));
+
+    std::string name;
+    db.prepare ("SELECT name FROM countries WHERE rowid = 2").execute () >> name;
+    ASSERT_EQ (name, "France");
+
+    db.prepare ("SELECT name FROM countries WHERE code = 'DE'").execute () >> name;
+    ASSERT_EQ (name, "Germany");
+
+    std::size_t count;
+    db.prepare ("SELECT COUNT (*) FROM countries WHERE code = 'XX'").execute () >> count;
+    ASSERT_EQ (count, 0);
+
+    // The keys are hashed as they are, other collations must not use them.
+    Statement nocase
+        = db.prepare ("SELECT name FROM countries WHERE code = 'ch' COLLATE NOCASE");
+    nocase.execute () >> name;
+    ASSERT_EQ (name, "Switzerland");
+
+    std::string plan;
+    Statement explain
+        = db.prepare ("EXPLAIN QUERY PLAN SELECT name FROM countries WHERE code = 'IT'");
+
+    for (auto [id, parent, unused, detail] :
+        explain.rows<int, int, int, std::string_view> ()) {
+        plan += detail;
+    }
+
+    ASSERT_NE (plan.find ("VIRTUAL TABLE INDEX 2"), std::string::npos);
+}
@@ -0,0 +1,197 @@
+/*
+ * LICENSE
+ *
+ * Copyright (c) 2026, David Daniel (dd), david.daniel@sphenic.ch
+ *
+ * transaction.cpp is free software copyrighted by David Daniel.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * This program comes with ABSOLUTELY NO WARRANTY.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions.
+ */
+#include <cqlite/transaction.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+
+using namespace cqlite;
+
+namespace {
+    Database createDatabase ()
+    {
+        Database db {":memory:"};
+        db << "CREATE TABLE foo (id INTEGER PRIMARY KEY, name TEXT)";
+
+        return db;
+    }
+
+    void insert (Database& db, const char* name)
+    {
+        Statement stmt = db.prepare ("INSERT INTO foo (name) VALUES (?1)");
+        stmt << name;
+        stmt.execute ();
+    }
+
+    std::size_t count (Database& db)
+    {
+        std::size_t count;
+        db.prepare ("SELECT COUNT (*) FROM foo").execute () >> count;
+
+        return count;
+    }
+} // namespace
+
+TEST (transaction, a_committed_transaction_keeps_its_changes)
+{
+    Database db = createDatabase ();
+
+    for (int i = 0; i < 3; ++i) {
+        Transaction transaction {db, Transaction::Type::Immediate};
+        insert (db, "Peter");
+        transaction.commit ();
+
+        ASSERT_FALSE (transaction.active ());
+    }
+
+    ASSERT_EQ (count (db), 3);
+}
+
+TEST (transaction, a_transaction_is_rolled_back_on_unwind)
+{
+    Database db = createDatabase ();
+
+    try {
+        Transaction transaction {db};
+        insert (db, "Peter");
+
+        throw std::runtime_error {"failure"};
+    }
+    catch (const std::runtime_error&) {
+    }
+
+    ASSERT_EQ (count (db), 0);
+}
+
+TEST (transaction, nested_savepoints_roll_back_independently)
+{
+    Database db = createDatabase ();
+
+    Transaction transaction {db};
+    insert (db, "Peter");
+
+    {
+        Savepoint outer {db};
+        insert (db, "Sue");
+
+        {
+            Savepoint inner {db};
+            insert (db, "Marc");
+        }
+
+        ASSERT_EQ (count (db), 2);
+
+        Savepoint again {db};
+        insert (db, "Marc");
+        again.release ();
+
+        outer.release ();
+    }
+
+    transaction.commit ();
+
+    ASSERT_EQ (count (db), 3);
+}
+
+TEST (transaction, savepoints_can_be_released_out_of_order)
+{
+    Database db = createDatabase ();
+
+    Transaction transaction {db};
+
+    {
+        std::optional<Savepoint> outer {std::in_place, db};
+        Savepoint inner {db};
+        insert (db, "Peter");
+
+        // Releases the inner savepoint as well, whose guard must leave it alone.
+        outer->release ();
+    }
+
+    {
+        std::optional<Savepoint> outer {std::in_place, db};
+        std::optional<Savepoint> stale {std::in_place, db};
+        outer->release ();
+
+        // New savepoints of the same depths, the stale guard must not roll them back.
+        Savepoint again {db};
+        insert (db, "Sue");
+        Savepoint inner {db};
+        insert (db, "Marc");
+
+        stale.reset ();
+
+        inner.release ();
+        again.release ();
+    }
+
+    transaction.commit ();
+
+    ASSERT_EQ (count (db), 3);
+
+    {
+        std::optional<Savepoint> outer {std::in_place, db};
+        Savepoint inner {db};
+        insert (db, "Marc");
+        outer->release ();
+    }
+
+    Savepoint last {db};
+    insert (db, "Anna");
+    last.rollback ();
+
+    ASSERT_EQ (count (db), 4);
+}
+
+TEST (transaction, savepoints_end_with_their_transaction)
+{
+    Database db = createDatabase ();
+    std::optional<Savepoint> stale;
+
+    {
+        Transaction transaction {db};
+        stale.emplace (db);
+        insert (db, "Peter");
+        transaction.commit ();
+    }
+
+    ASSERT_FALSE (stale->active ());
+
+    Transaction transaction {db};
+    Savepoint savepoint {db};
+    insert (db, "Sue");
+
+    // The stale guard must not roll back the savepoint of the new transaction.
+    stale.reset ();
+
+    ASSERT_TRUE (savepoint.active ());
+    savepoint.release ();
+    transaction.commit ();
+
+    ASSERT_EQ (count (db), 2);
+}